@@ -0,0 +1,1350 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <pthread.h>
+#include <sched.h>
+#include <map>
+#include <queue>
+#include <stack>
+#include <string>
+#include <tr1/unordered_map>
+#include <vector>
+#include "deque.hpp"
+#include "flat_hash_map.hpp"
+#include "flat_map.hpp"
+#include "interval_map.hpp"
+#include "list.hpp"
+#include "lockfree_stack.hpp"
+#include "map.hpp"
+#include "mpmc_queue.hpp"
+#include "persistent_map.hpp"
+#include "pool_allocator.hpp"
+#include "queue.hpp"
+#include "spsc_queue.hpp"
+#include "stack.hpp"
+#include "unordered_map.hpp"
+#include "vector.hpp"
+
+// Every benchmark case runs for both the ft and the std containers, in the
+// same binary, so the numbers can be compared directly. Each case is run a
+// few times to warm up, then timed for a number of repetitions at every size.
+// The results are printed to stdout as CSV, or as JSON with --json.
+
+// The iterators of the ft containers have tags of their own, which the std
+// algorithms don't know. This tells std::find and std::sort that the vector
+// and deque iterators are random access.
+namespace std
+{
+	template <class T, class Pointer, class Reference, class Category>
+	struct iterator_traits<ft::RandomAccessIterator<T, Pointer, Reference, Category> >
+	{
+		typedef random_access_iterator_tag	iterator_category;
+		typedef T							value_type;
+		typedef ptrdiff_t					difference_type;
+		typedef Pointer						pointer;
+		typedef Reference					reference;
+	};
+	template <class T, class Pointer, class Reference>
+	struct iterator_traits<ft::DequeIterator<T, Pointer, Reference> >
+	{
+		typedef random_access_iterator_tag	iterator_category;
+		typedef T							value_type;
+		typedef ptrdiff_t					difference_type;
+		typedef Pointer						pointer;
+		typedef Reference					reference;
+	};
+}
+
+// Results are added to this, so the compiler can't optimize the work away.
+volatile long	sink;
+
+// This timer measures the time between start and stop with a monotonic clock.
+// Setup work in a benchmark case is kept outside of a start/stop pair.
+class Timer
+{
+	public:
+		Timer() : _elapsed(0)
+		{
+		}
+
+		void	start()
+		{
+			clock_gettime(CLOCK_MONOTONIC, &this->_begin);
+		}
+		void	stop()
+		{
+			struct timespec		end;
+
+			clock_gettime(CLOCK_MONOTONIC, &end);
+			this->_elapsed += (end.tv_sec - this->_begin.tv_sec) * 1e+9;
+			this->_elapsed += end.tv_nsec - this->_begin.tv_nsec;
+		}
+		void	reset()
+		{
+			this->_elapsed = 0;
+		}
+		double	elapsed() const
+		{
+			return this->_elapsed;
+		}
+
+	private:
+		struct timespec		_begin;
+		double				_elapsed;
+};
+
+// A benchmark case gets a timer and a size. It returns the amount of items
+// that were processed, which is used to report the time per item.
+typedef std::size_t (*benchFunction)(Timer &timer, std::size_t n);
+
+// The amount of elements that the insert and erase cases add to or remove
+// from the middle of a container of the benchmark size.
+static const std::size_t	middleOperations = 1000;
+
+////////////
+// VECTOR //
+////////////
+// Push back n elements.
+template <class Vector>
+std::size_t		vectorPushBack(Timer &timer, std::size_t n)
+{
+	Vector		vec;
+
+	timer.start();
+	for (std::size_t i = 0; i < n; i++)
+		vec.push_back(i);
+	timer.stop();
+	sink += vec.back();
+	return n;
+}
+
+// Insert elements in the middle of a vector of n elements.
+template <class Vector>
+std::size_t		vectorInsert(Timer &timer, std::size_t n)
+{
+	Vector		vec(n, 1);
+
+	timer.start();
+	for (std::size_t i = 0; i < middleOperations; i++)
+		vec.insert(vec.begin() + vec.size() / 2, i);
+	timer.stop();
+	sink += vec[n / 2];
+	return middleOperations;
+}
+
+// Erase elements from the middle of a vector of n elements.
+template <class Vector>
+std::size_t		vectorErase(Timer &timer, std::size_t n)
+{
+	Vector		vec(n + middleOperations, 1);
+
+	timer.start();
+	for (std::size_t i = 0; i < middleOperations; i++)
+		vec.erase(vec.begin() + vec.size() / 2);
+	timer.stop();
+	sink += vec.size();
+	return middleOperations;
+}
+
+// Iterate over a vector of n elements.
+template <class Vector>
+std::size_t		vectorIterate(Timer &timer, std::size_t n)
+{
+	Vector						vec(n, 1);
+	typename Vector::iterator	it;
+	long						sum;
+
+	sum = 0;
+	timer.start();
+	for (it = vec.begin(); it != vec.end(); it++)
+		sum += *it;
+	timer.stop();
+	sink += sum;
+	return n;
+}
+
+// The amount of values that vectorFind looks for.
+static const std::size_t	findOperations = 16;
+
+// Look for values in a vector of n random elements with std::find. The
+// values are spread over the vector, so on average half of it is walked.
+template <class Vector>
+std::size_t		vectorFind(Timer &timer, std::size_t n)
+{
+	Vector						vec;
+	typename Vector::iterator	it;
+	std::size_t					walked;
+
+	srand(n);
+	for (std::size_t i = 0; i < n; i++)
+		vec.push_back(rand());
+	walked = 0;
+	timer.start();
+	for (std::size_t i = 0; i < findOperations; i++)
+	{
+		it = std::find(vec.begin(), vec.end(), vec[i * n / findOperations]);
+		walked += it - vec.begin() + 1;
+	}
+	timer.stop();
+	sink += walked;
+	return walked;
+}
+
+// Sort a vector of n random elements with std::sort.
+template <class Vector>
+std::size_t		vectorSort(Timer &timer, std::size_t n)
+{
+	Vector		vec;
+
+	srand(n);
+	for (std::size_t i = 0; i < n; i++)
+		vec.push_back(rand());
+	timer.start();
+	std::sort(vec.begin(), vec.end());
+	timer.stop();
+	sink += vec.front();
+	return n;
+}
+
+// Copy a vector of n elements.
+template <class Vector>
+std::size_t		vectorCopy(Timer &timer, std::size_t n)
+{
+	Vector		vec(n, 1);
+
+	timer.start();
+	Vector		copy(vec);
+	timer.stop();
+	sink += copy.size();
+	return n;
+}
+
+//////////
+// LIST //
+//////////
+// Push back n elements.
+template <class List>
+std::size_t		listPushBack(Timer &timer, std::size_t n)
+{
+	List		lst;
+
+	timer.start();
+	for (std::size_t i = 0; i < n; i++)
+		lst.push_back(i);
+	timer.stop();
+	sink += lst.back();
+	return n;
+}
+
+// Insert elements in the middle of a list of n elements.
+template <class List>
+std::size_t		listInsert(Timer &timer, std::size_t n)
+{
+	List						lst(n, 1);
+	typename List::iterator		it;
+
+	it = lst.begin();
+	for (std::size_t i = 0; i < n / 2; i++)
+		it++;
+	timer.start();
+	for (std::size_t i = 0; i < middleOperations; i++)
+		lst.insert(it, i);
+	timer.stop();
+	sink += lst.size();
+	return middleOperations;
+}
+
+// Erase elements from the middle of a list of n elements.
+template <class List>
+std::size_t		listErase(Timer &timer, std::size_t n)
+{
+	List						lst(n + middleOperations, 1);
+	typename List::iterator		it;
+
+	it = lst.begin();
+	for (std::size_t i = 0; i < n / 2; i++)
+		it++;
+	timer.start();
+	for (std::size_t i = 0; i < middleOperations; i++)
+		it = lst.erase(it);
+	timer.stop();
+	sink += lst.size();
+	return middleOperations;
+}
+
+// Iterate over a list of n elements.
+template <class List>
+std::size_t		listIterate(Timer &timer, std::size_t n)
+{
+	List						lst(n, 1);
+	typename List::iterator		it;
+	long						sum;
+
+	sum = 0;
+	timer.start();
+	for (it = lst.begin(); it != lst.end(); it++)
+		sum += *it;
+	timer.stop();
+	sink += sum;
+	return n;
+}
+
+// Sort a list of n random elements.
+template <class List>
+std::size_t		listSort(Timer &timer, std::size_t n)
+{
+	List		lst;
+
+	srand(n);
+	for (std::size_t i = 0; i < n; i++)
+		lst.push_back(rand());
+	timer.start();
+	lst.sort();
+	timer.stop();
+	sink += lst.front();
+	return n;
+}
+
+// Copy a list of n elements.
+template <class List>
+std::size_t		listCopy(Timer &timer, std::size_t n)
+{
+	List		lst(n, 1);
+
+	timer.start();
+	List		copy(lst);
+	timer.stop();
+	sink += copy.size();
+	return n;
+}
+
+///////////
+// DEQUE //
+///////////
+// Push n elements at the front.
+template <class Deque>
+std::size_t		dequePushFront(Timer &timer, std::size_t n)
+{
+	Deque		dq;
+
+	timer.start();
+	for (std::size_t i = 0; i < n; i++)
+		dq.push_front(i);
+	timer.stop();
+	sink += dq.front();
+	return n;
+}
+
+// Pop n elements from the front.
+template <class Deque>
+std::size_t		dequePopFront(Timer &timer, std::size_t n)
+{
+	Deque		dq(n, 1);
+
+	timer.start();
+	for (std::size_t i = 0; i < n; i++)
+		dq.pop_front();
+	timer.stop();
+	sink += dq.size();
+	return n;
+}
+
+// Read every element of a deque of n elements by index.
+template <class Deque>
+std::size_t		dequeIndex(Timer &timer, std::size_t n)
+{
+	Deque		dq(n, 1);
+	long		sum;
+
+	sum = 0;
+	timer.start();
+	for (std::size_t i = 0; i < n; i++)
+		sum += dq[i];
+	timer.stop();
+	sink += sum;
+	return n;
+}
+
+/////////
+// MAP //
+/////////
+// Gives k the value v. A persistent map has no operator[], since the value it
+// returns could be shared with a snapshot.
+template <class Map>
+void			assignValue(Map &m, int k, int v)
+{
+	m[k] = v;
+}
+template <class Key, class T>
+void			assignValue(ft::persistent_map<Key, T> &m, int k, int v)
+{
+	m.insert_or_assign(k, v);
+}
+
+// Fills a map with n random keys. The same keys are used for every run.
+template <class Map>
+void			fillMap(Map &m, std::size_t n)
+{
+	srand(n);
+	for (std::size_t i = 0; i < n; i++)
+		assignValue(m, rand(), i);
+}
+
+// Insert n random keys.
+template <class Map>
+std::size_t		mapInsert(Timer &timer, std::size_t n)
+{
+	Map			m;
+
+	timer.start();
+	fillMap(m, n);
+	timer.stop();
+	sink += m.size();
+	return n;
+}
+
+// Erase all keys of a map with n random keys, in the order they were added.
+template <class Map>
+std::size_t		mapErase(Timer &timer, std::size_t n)
+{
+	Map			m;
+
+	fillMap(m, n);
+	srand(n);
+	timer.start();
+	for (std::size_t i = 0; i < n; i++)
+		m.erase(rand());
+	timer.stop();
+	sink += m.size();
+	return n;
+}
+
+// Find n keys in a map with n random keys. About half of them are missing.
+template <class Map>
+std::size_t		mapFind(Timer &timer, std::size_t n)
+{
+	Map			m;
+	long		found;
+
+	fillMap(m, n);
+	srand(n);
+	found = 0;
+	timer.start();
+	for (std::size_t i = 0; i < n; i++)
+		found += (m.find(i % 2 ? rand() : i) != m.end());
+	timer.stop();
+	sink += found;
+	return n;
+}
+
+// Iterate over a map with n random keys.
+template <class Map>
+std::size_t		mapIterate(Timer &timer, std::size_t n)
+{
+	Map							m;
+	typename Map::iterator		it;
+	long						sum;
+
+	fillMap(m, n);
+	sum = 0;
+	timer.start();
+	for (it = m.begin(); it != m.end(); it++)
+		sum += it->second;
+	timer.stop();
+	sink += sum;
+	return n;
+}
+
+// Copy a map with n random keys.
+template <class Map>
+std::size_t		mapCopy(Timer &timer, std::size_t n)
+{
+	Map			m;
+
+	fillMap(m, n);
+	timer.start();
+	Map			copy(m);
+	timer.stop();
+	sink += copy.size();
+	return n;
+}
+
+// Clear a map with n random keys.
+template <class Map>
+std::size_t		mapClear(Timer &timer, std::size_t n)
+{
+	Map			m;
+
+	fillMap(m, n);
+	timer.start();
+	m.clear();
+	timer.stop();
+	sink += m.size();
+	return n;
+}
+
+// The element at position n. A map without order statistics has to walk
+// there.
+template <class Map>
+typename Map::iterator	nthElement(Map &m, std::size_t n)
+{
+	typename Map::iterator	it = m.begin();
+
+	while (n-- > 0)
+		it++;
+	return it;
+}
+template <class Key, class T, class Compare, class Alloc>
+typename ft::map<Key, T, Compare, Alloc, ft::order_statistics>::iterator
+				nthElement(ft::map<Key, T, Compare, Alloc, ft::order_statistics> &m, std::size_t n)
+{
+	return m.nth(n);
+}
+
+// The amount of windows that mapPercentile slides over.
+static const std::size_t	percentileQueries = 50;
+
+// Slide a window over a map with n random keys: replace one key, then look up
+// the median and the 99th percentile.
+template <class Map>
+std::size_t		mapPercentile(Timer &timer, std::size_t n)
+{
+	Map			m;
+	long		sum;
+
+	fillMap(m, n);
+	srand(n);
+	sum = 0;
+	timer.start();
+	for (std::size_t i = 0; i < percentileQueries; i++)
+	{
+		m.erase(m.begin());
+		m[rand()] = i;
+		sum += nthElement(m, m.size() / 2)->first + nthElement(m, m.size() * 99 / 100)->first;
+	}
+	timer.stop();
+	sink += sum;
+	return percentileQueries;
+}
+
+// Turns a number into a string key with a long common prefix, so comparing
+// two keys has to look at most of their characters.
+std::string		stringKey(int value)
+{
+	std::string		key("/usr/share/benchmark/keys/");
+
+	while (value > 0)
+	{
+		key += static_cast<char>('a' + value % 26);
+		value /= 26;
+	}
+	return key;
+}
+
+// Find n string keys in a map with n random string keys. About half of them
+// are missing.
+template <class Map>
+std::size_t		stringMapFind(Timer &timer, std::size_t n)
+{
+	Map							m;
+	std::vector<std::string>	keys;
+	long						found;
+
+	srand(n);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		keys.push_back(stringKey(rand()));
+		m[keys.back()] = i;
+		if (i % 2)
+			keys.back() += '!';
+	}
+	found = 0;
+	timer.start();
+	for (std::size_t i = 0; i < n; i++)
+		found += (m.find(keys[i]) != m.end());
+	timer.stop();
+	sink += found;
+	return n;
+}
+
+// Fills a map with the same n random keys as fillMap, with one range insert.
+template <class Map>
+void			fillMapBulk(Map &m, std::size_t n)
+{
+	std::vector<std::pair<int, int> >	pairs;
+
+	srand(n);
+	for (std::size_t i = 0; i < n; i++)
+		pairs.push_back(std::make_pair(rand(), i));
+	m.insert(pairs.begin(), pairs.end());
+}
+
+// Insert n random keys with one range insert.
+template <class Map>
+std::size_t		mapBulkInsert(Timer &timer, std::size_t n)
+{
+	Map			m;
+
+	timer.start();
+	fillMapBulk(m, n);
+	timer.stop();
+	sink += m.size();
+	return n;
+}
+
+// Find n keys in a map that was built with a range insert. About half of
+// them are missing.
+template <class Map>
+std::size_t		mapBulkFind(Timer &timer, std::size_t n)
+{
+	Map			m;
+	long		found;
+
+	fillMapBulk(m, n);
+	srand(n);
+	found = 0;
+	timer.start();
+	for (std::size_t i = 0; i < n; i++)
+		found += (m.find(i % 2 ? rand() : i) != m.end());
+	timer.stop();
+	sink += found;
+	return n;
+}
+
+////////////////////
+// FLAT HASH MAPS //
+////////////////////
+// The slots of a swiss table that is at least n slots big: the smallest power
+// of two minus one that is at least n.
+std::size_t		tableCapacity(std::size_t n)
+{
+	std::size_t		capacity = 1;
+
+	while (capacity < n)
+		capacity = capacity * 2 + 1;
+	return capacity;
+}
+
+// Makes a hash map capacity slots big before it is filled. A map has no slots.
+template <class Map>
+void			presize(Map &m, std::size_t capacity)
+{
+	m.rehash(capacity);
+}
+template <class Key, class T>
+void			presize(ft::map<Key, T> &, std::size_t)
+{
+}
+
+// Find n keys in a hash map that has Load per mille of its slots filled. Half
+// of them are missing, and a miss has to probe until it finds an empty slot,
+// so that is where the load shows most.
+template <class Map, std::size_t Load>
+std::size_t		mapLoadFind(Timer &timer, std::size_t n)
+{
+	Map				m;
+	std::size_t		capacity = tableCapacity(n);
+	long			found;
+
+	presize(m, capacity);
+	fillMap(m, capacity * Load / 1000);
+	srand(capacity * Load / 1000);
+	found = 0;
+	timer.start();
+	for (std::size_t i = 0; i < n; i++)
+		found += (m.find(i % 2 ? rand() : -1 - static_cast<int>(i)) != m.end());
+	timer.stop();
+	sink += found;
+	return n;
+}
+
+//////////////////
+// INTERVAL MAP //
+//////////////////
+// The amount of overlap queries that intervalOverlaps runs.
+static const std::size_t	overlapQueries = 100;
+
+// Finds the intervals that overlap [a, b]. A map of intervals without the
+// highest ends in its nodes has to look at every interval that starts before
+// b.
+template <class Map>
+std::size_t		countOverlaps(Map &m, int a, int b)
+{
+	std::size_t		count = 0;
+
+	for (typename Map::iterator it = m.begin(); it != m.end() && !(b < it->first.first); it++)
+		count += !(it->first.second < a);
+	return count;
+}
+template <class Point, class T>
+std::size_t		countOverlaps(ft::interval_map<Point, T> &m, int a, int b)
+{
+	std::vector<typename ft::interval_map<Point, T>::iterator>	found;
+
+	m.overlaps(a, b, std::back_inserter(found));
+	return found.size();
+}
+
+// Find the intervals that overlap a short range, in a map with n random
+// intervals of up to a thousand long.
+template <class Map>
+std::size_t		intervalOverlaps(Timer &timer, std::size_t n)
+{
+	Map			m;
+	int			start;
+	long		found;
+
+	srand(n);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		start = rand();
+		m[typename Map::key_type(start, start + rand() % 1000)] = i;
+	}
+	found = 0;
+	timer.start();
+	for (std::size_t i = 0; i < overlapQueries; i++)
+	{
+		start = rand();
+		found += countOverlaps(m, start, start + 1000);
+	}
+	timer.stop();
+	sink += found;
+	return overlapQueries;
+}
+
+////////////////////
+// PERSISTENT MAP //
+////////////////////
+// The amount of snapshots that snapshotWrites takes, and the amount of writes
+// after each of them.
+static const std::size_t	snapshotRounds = 20;
+static const std::size_t	writesPerSnapshot = 10;
+
+// Take a snapshot of a map with n elements, and keep writing to the map while
+// the snapshot is still around, like a reader would hold on to it. A snapshot
+// of a std::map is a full copy, one of a persistent map shares the nodes.
+template <class Map>
+std::size_t		snapshotWrites(Timer &timer, std::size_t n)
+{
+	Map			m;
+	Map			snapshot;
+
+	for (std::size_t i = 0; i < n; i++)
+		assignValue(m, i, i);
+	timer.start();
+	for (std::size_t i = 0; i < snapshotRounds; i++)
+	{
+		snapshot = m;
+		for (std::size_t j = 0; j < writesPerSnapshot; j++)
+			assignValue(m, rand() % n, j);
+	}
+	timer.stop();
+	sink += snapshot.size();
+	return snapshotRounds * writesPerSnapshot;
+}
+
+///////////////////////
+// STACKS AND QUEUES //
+///////////////////////
+// Push n elements.
+template <class Adaptor>
+std::size_t		adaptorPush(Timer &timer, std::size_t n)
+{
+	Adaptor		a;
+
+	timer.start();
+	for (std::size_t i = 0; i < n; i++)
+		a.push(i);
+	timer.stop();
+	sink += a.size();
+	return n;
+}
+
+// Pop n elements.
+template <class Adaptor>
+std::size_t		adaptorPop(Timer &timer, std::size_t n)
+{
+	Adaptor		a;
+
+	for (std::size_t i = 0; i < n; i++)
+		a.push(i);
+	timer.start();
+	for (std::size_t i = 0; i < n; i++)
+		a.pop();
+	timer.stop();
+	sink += a.size();
+	return n;
+}
+
+///////////////////////
+// CONCURRENT QUEUES //
+///////////////////////
+// The way to share a queue between threads without the concurrent queues: a
+// std::queue behind a mutex. It is bounded like the concurrent queues are.
+template <class T, std::size_t N>
+class MutexQueue
+{
+	public:
+		MutexQueue()
+		{
+			pthread_mutex_init(&this->_mutex, NULL);
+		}
+		~MutexQueue()
+		{
+			pthread_mutex_destroy(&this->_mutex);
+		}
+
+		bool	try_push(const T &val)
+		{
+			bool	pushed;
+
+			pthread_mutex_lock(&this->_mutex);
+			pushed = (this->_queue.size() < N);
+			if (pushed)
+				this->_queue.push(val);
+			pthread_mutex_unlock(&this->_mutex);
+			return pushed;
+		}
+		bool	try_pop(T &val)
+		{
+			bool	popped;
+
+			pthread_mutex_lock(&this->_mutex);
+			popped = !this->_queue.empty();
+			if (popped)
+			{
+				val = this->_queue.front();
+				this->_queue.pop();
+			}
+			pthread_mutex_unlock(&this->_mutex);
+			return popped;
+		}
+
+	private:
+		std::queue<T>		_queue;
+		pthread_mutex_t		_mutex;
+};
+
+// The work for a producer thread: push count numbers into a queue.
+template <class Queue>
+struct ProducerTask
+{
+	Queue			*queue;
+	std::size_t		count;
+
+	static void		*run(void *arg)
+	{
+		ProducerTask	*task = static_cast<ProducerTask *>(arg);
+
+		for (std::size_t i = 0; i < task->count; i++)
+			while (!task->queue->try_push(i))
+				sched_yield();
+		return NULL;
+	}
+};
+
+// Move n numbers from a producer thread to the consumer on this thread.
+template <class Queue>
+std::size_t		queueTransfer(Timer &timer, std::size_t n)
+{
+	Queue					queue;
+	ProducerTask<Queue>		task;
+	pthread_t				producer;
+	long					val;
+	long					sum;
+
+	task.queue = &queue;
+	task.count = n;
+	sum = 0;
+	timer.start();
+	pthread_create(&producer, NULL, ProducerTask<Queue>::run, &task);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		while (!queue.try_pop(val))
+			sched_yield();
+		sum += val;
+	}
+	pthread_join(producer, NULL);
+	timer.stop();
+	sink += sum;
+	return n;
+}
+
+// The work for a consumer thread: pop count numbers from a queue.
+template <class Queue>
+struct ConsumerTask
+{
+	Queue			*queue;
+	std::size_t		count;
+	long			sum;
+
+	static void		*run(void *arg)
+	{
+		ConsumerTask	*task = static_cast<ConsumerTask *>(arg);
+		long			val;
+
+		task->sum = 0;
+		for (std::size_t i = 0; i < task->count; i++)
+		{
+			while (!task->queue->try_pop(val))
+				sched_yield();
+			task->sum += val;
+		}
+		return NULL;
+	}
+};
+
+// Move n numbers from Producers producer threads to Consumers consumer
+// threads, through one queue.
+template <class Queue, std::size_t Producers, std::size_t Consumers>
+std::size_t		queueThreads(Timer &timer, std::size_t n)
+{
+	Queue							queue;
+	ProducerTask<Queue>				producerTasks[Producers];
+	ConsumerTask<Queue>				consumerTasks[Consumers];
+	pthread_t						producers[Producers];
+	pthread_t						consumers[Consumers];
+	std::size_t						total;
+
+	total = n / Producers * Producers;
+	for (std::size_t i = 0; i < Producers; i++)
+	{
+		producerTasks[i].queue = &queue;
+		producerTasks[i].count = n / Producers;
+	}
+	for (std::size_t i = 0; i < Consumers; i++)
+	{
+		consumerTasks[i].queue = &queue;
+		consumerTasks[i].count = total / Consumers + (i < total % Consumers);
+	}
+	timer.start();
+	for (std::size_t i = 0; i < Consumers; i++)
+		pthread_create(&consumers[i], NULL, ConsumerTask<Queue>::run, &consumerTasks[i]);
+	for (std::size_t i = 0; i < Producers; i++)
+		pthread_create(&producers[i], NULL, ProducerTask<Queue>::run, &producerTasks[i]);
+	for (std::size_t i = 0; i < Producers; i++)
+		pthread_join(producers[i], NULL);
+	for (std::size_t i = 0; i < Consumers; i++)
+		pthread_join(consumers[i], NULL);
+	timer.stop();
+	for (std::size_t i = 0; i < Consumers; i++)
+		sink += consumerTasks[i].sum;
+	return total;
+}
+
+///////////////////////
+// CONCURRENT STACKS //
+///////////////////////
+// A std::stack behind a mutex, to compare the lock-free stack with.
+template <class T>
+class MutexStack
+{
+	public:
+		MutexStack()
+		{
+			pthread_mutex_init(&this->_mutex, NULL);
+		}
+		~MutexStack()
+		{
+			pthread_mutex_destroy(&this->_mutex);
+		}
+
+		void	push(const T &val)
+		{
+			pthread_mutex_lock(&this->_mutex);
+			this->_stack.push(val);
+			pthread_mutex_unlock(&this->_mutex);
+		}
+		bool	try_pop(T &val)
+		{
+			bool	popped;
+
+			pthread_mutex_lock(&this->_mutex);
+			popped = !this->_stack.empty();
+			if (popped)
+			{
+				val = this->_stack.top();
+				this->_stack.pop();
+			}
+			pthread_mutex_unlock(&this->_mutex);
+			return popped;
+		}
+
+	private:
+		std::stack<T>		_stack;
+		pthread_mutex_t		_mutex;
+};
+
+// The work for a thread that uses a stack as a pool of free objects: take one
+// out if there is one, and put it back.
+template <class Stack>
+struct PoolTask
+{
+	Stack			*stack;
+	std::size_t		count;
+	long			sum;
+
+	static void		*run(void *arg)
+	{
+		PoolTask	*task = static_cast<PoolTask *>(arg);
+		long		val;
+
+		task->sum = 0;
+		for (std::size_t i = 0; i < task->count; i++)
+		{
+			if (!task->stack->try_pop(val))
+				val = i;
+			task->sum += val;
+			task->stack->push(val);
+		}
+		return NULL;
+	}
+};
+
+// Let Threads threads take n objects out of a shared pool and put them back.
+template <class Stack, std::size_t Threads>
+std::size_t		stackPool(Timer &timer, std::size_t n)
+{
+	Stack					stack;
+	PoolTask<Stack>			tasks[Threads];
+	pthread_t				threads[Threads];
+
+	for (std::size_t i = 0; i < Threads; i++)
+	{
+		tasks[i].stack = &stack;
+		tasks[i].count = n / Threads;
+		stack.push(i);
+	}
+	timer.start();
+	for (std::size_t i = 0; i < Threads; i++)
+		pthread_create(&threads[i], NULL, PoolTask<Stack>::run, &tasks[i]);
+	for (std::size_t i = 0; i < Threads; i++)
+		pthread_join(threads[i], NULL);
+	timer.stop();
+	for (std::size_t i = 0; i < Threads; i++)
+		sink += tasks[i].sum;
+	return n / Threads * Threads;
+}
+
+////////////
+// RUNNER //
+////////////
+// A single benchmark case for a single implementation.
+struct Benchmark
+{
+	std::string		container;
+	std::string		operation;
+	std::string		implementation;
+	benchFunction	func;
+};
+
+// The settings that can be changed from the command line.
+struct Options
+{
+	int							warmup;
+	int							repetitions;
+	bool						json;
+	std::string					filter;
+	std::vector<std::size_t>	sizes;
+};
+
+// The statistics of all repetitions of a benchmark case at a single size.
+struct Result
+{
+	double			median;
+	double			p99;
+	double			min;
+	double			mean;
+	std::size_t		items;
+};
+
+// Adds a case for both the ft and the std version of a container.
+void	addBenchmark(std::vector<Benchmark> &benchmarks, std::string const &container,
+			std::string const &operation, benchFunction ftFunc, benchFunction stdFunc)
+{
+	Benchmark	benchmark;
+
+	benchmark.container = container;
+	benchmark.operation = operation;
+	benchmark.implementation = "ft";
+	benchmark.func = ftFunc;
+	benchmarks.push_back(benchmark);
+	benchmark.implementation = "std";
+	benchmark.func = stdFunc;
+	benchmarks.push_back(benchmark);
+}
+
+// This function runs a benchmark case at a single size, and calculates the
+// statistics of the timed repetitions. The warm-up runs are not counted.
+Result	runBenchmark(Benchmark const &benchmark, std::size_t n, Options const &options)
+{
+	Timer					timer;
+	std::vector<double>		samples;
+	Result					result;
+	double					total;
+	std::size_t				rank;
+
+	for (int i = 0; i < options.warmup; i++)
+		benchmark.func(timer, n);
+	for (int i = 0; i < options.repetitions; i++)
+	{
+		timer.reset();
+		result.items = benchmark.func(timer, n);
+		samples.push_back(timer.elapsed());
+	}
+	std::sort(samples.begin(), samples.end());
+	if (samples.size() % 2)
+		result.median = samples[samples.size() / 2];
+	else
+		result.median = (samples[samples.size() / 2 - 1] + samples[samples.size() / 2]) / 2;
+	rank = static_cast<std::size_t>(std::ceil(0.99 * samples.size()));
+	result.p99 = samples[rank - 1];
+	result.min = samples[0];
+	total = 0;
+	for (std::size_t i = 0; i < samples.size(); i++)
+		total += samples[i];
+	result.mean = total / samples.size();
+	return result;
+}
+
+// This function prints the result of a benchmark case as a CSV row or a JSON
+// object. All times are in nanoseconds.
+void	printResult(Benchmark const &benchmark, std::size_t n, Result const &result,
+			Options const &options, bool first)
+{
+	if (options.json)
+	{
+		std::cout << (first ? "  " : ", ");
+		std::cout << "{\"container\": \"" << benchmark.container << "\"";
+		std::cout << ", \"operation\": \"" << benchmark.operation << "\"";
+		std::cout << ", \"implementation\": \"" << benchmark.implementation << "\"";
+		std::cout << ", \"size\": " << n;
+		std::cout << ", \"repetitions\": " << options.repetitions;
+		std::cout << ", \"median_ns\": " << result.median;
+		std::cout << ", \"p99_ns\": " << result.p99;
+		std::cout << ", \"min_ns\": " << result.min;
+		std::cout << ", \"mean_ns\": " << result.mean;
+		std::cout << ", \"median_ns_per_item\": " << result.median / result.items;
+		std::cout << "}" << std::endl;
+		return ;
+	}
+	std::cout << benchmark.container << "," << benchmark.operation << ",";
+	std::cout << benchmark.implementation << "," << n << ",";
+	std::cout << options.repetitions << "," << result.median << ",";
+	std::cout << result.p99 << "," << result.min << "," << result.mean << ",";
+	std::cout << result.median / result.items << std::endl;
+}
+
+// This function reads the command line arguments. It returns false if they
+// are not valid.
+bool	parseOptions(int argc, char **argv, Options &options)
+{
+	std::string		arg;
+	char			*size;
+
+	options.warmup = 2;
+	options.repetitions = 15;
+	options.json = false;
+	for (int i = 1; i < argc; i++)
+	{
+		arg = argv[i];
+		if (arg == "--json")
+			options.json = true;
+		else if (arg == "--warmup" && i + 1 < argc)
+			options.warmup = std::atoi(argv[++i]);
+		else if (arg == "--repetitions" && i + 1 < argc)
+			options.repetitions = std::atoi(argv[++i]);
+		else if (arg == "--filter" && i + 1 < argc)
+			options.filter = argv[++i];
+		else if (arg == "--sizes" && i + 1 < argc)
+		{
+			for (size = std::strtok(argv[++i], ","); size; size = std::strtok(NULL, ","))
+				options.sizes.push_back(std::strtoul(size, NULL, 10));
+		}
+		else
+			return false;
+	}
+	if (options.sizes.empty())
+	{
+		options.sizes.push_back(1000);
+		options.sizes.push_back(10000);
+		options.sizes.push_back(100000);
+	}
+	return (options.warmup >= 0 && options.repetitions > 0);
+}
+
+int main(int argc, char **argv)
+{
+	Options						options;
+	std::vector<Benchmark>		benchmarks;
+	bool						first;
+
+	if (!parseOptions(argc, argv, options))
+	{
+		std::cerr << "Usage: " << argv[0] << " [--json] [--warmup N] [--repetitions N]"
+			<< " [--filter TEXT] [--sizes N,N,...]" << std::endl;
+		return 1;
+	}
+
+	addBenchmark(benchmarks, "vector", "push_back",
+		vectorPushBack<ft::vector<int> >, vectorPushBack<std::vector<int> >);
+	addBenchmark(benchmarks, "vector", "insert",
+		vectorInsert<ft::vector<int> >, vectorInsert<std::vector<int> >);
+	addBenchmark(benchmarks, "vector", "erase",
+		vectorErase<ft::vector<int> >, vectorErase<std::vector<int> >);
+	addBenchmark(benchmarks, "vector", "iterate",
+		vectorIterate<ft::vector<int> >, vectorIterate<std::vector<int> >);
+	addBenchmark(benchmarks, "vector", "find",
+		vectorFind<ft::vector<int> >, vectorFind<std::vector<int> >);
+	addBenchmark(benchmarks, "vector", "sort",
+		vectorSort<ft::vector<int> >, vectorSort<std::vector<int> >);
+	addBenchmark(benchmarks, "vector", "copy",
+		vectorCopy<ft::vector<int> >, vectorCopy<std::vector<int> >);
+	addBenchmark(benchmarks, "list", "push_back",
+		listPushBack<ft::list<int> >, listPushBack<std::list<int> >);
+	addBenchmark(benchmarks, "list", "insert",
+		listInsert<ft::list<int> >, listInsert<std::list<int> >);
+	addBenchmark(benchmarks, "list", "erase",
+		listErase<ft::list<int> >, listErase<std::list<int> >);
+	addBenchmark(benchmarks, "list", "iterate",
+		listIterate<ft::list<int> >, listIterate<std::list<int> >);
+	addBenchmark(benchmarks, "list", "sort",
+		listSort<ft::list<int> >, listSort<std::list<int> >);
+	addBenchmark(benchmarks, "list", "copy",
+		listCopy<ft::list<int> >, listCopy<std::list<int> >);
+	addBenchmark(benchmarks, "deque", "push_back",
+		vectorPushBack<ft::deque<int> >, vectorPushBack<std::deque<int> >);
+	addBenchmark(benchmarks, "deque", "push_front",
+		dequePushFront<ft::deque<int> >, dequePushFront<std::deque<int> >);
+	addBenchmark(benchmarks, "deque", "pop_front",
+		dequePopFront<ft::deque<int> >, dequePopFront<std::deque<int> >);
+	addBenchmark(benchmarks, "deque", "index",
+		dequeIndex<ft::deque<int> >, dequeIndex<std::deque<int> >);
+	addBenchmark(benchmarks, "deque", "iterate",
+		vectorIterate<ft::deque<int> >, vectorIterate<std::deque<int> >);
+	addBenchmark(benchmarks, "deque", "find",
+		vectorFind<ft::deque<int> >, vectorFind<std::deque<int> >);
+	addBenchmark(benchmarks, "deque", "sort",
+		vectorSort<ft::deque<int> >, vectorSort<std::deque<int> >);
+	addBenchmark(benchmarks, "deque", "copy",
+		vectorCopy<ft::deque<int> >, vectorCopy<std::deque<int> >);
+	addBenchmark(benchmarks, "map", "insert",
+		mapInsert<ft::map<int, int> >, mapInsert<std::map<int, int> >);
+	addBenchmark(benchmarks, "map", "erase",
+		mapErase<ft::map<int, int> >, mapErase<std::map<int, int> >);
+	addBenchmark(benchmarks, "map", "find",
+		mapFind<ft::map<int, int> >, mapFind<std::map<int, int> >);
+	addBenchmark(benchmarks, "map", "iterate",
+		mapIterate<ft::map<int, int> >, mapIterate<std::map<int, int> >);
+	addBenchmark(benchmarks, "map", "copy",
+		mapCopy<ft::map<int, int> >, mapCopy<std::map<int, int> >);
+	addBenchmark(benchmarks, "map", "string find",
+		stringMapFind<ft::map<std::string, int> >, stringMapFind<std::map<std::string, int> >);
+	addBenchmark(benchmarks, "map", "percentile",
+		mapPercentile<ft::map<int, int, ft::less<int>, std::allocator<ft::pair<const int, int> >,
+			ft::order_statistics> >,
+		mapPercentile<std::map<int, int> >);
+	addBenchmark(benchmarks, "map", "clear",
+		mapClear<ft::map<int, int> >, mapClear<std::map<int, int> >);
+	addBenchmark(benchmarks, "map", "pooled clear",
+		mapClear<ft::map<int, int, ft::less<int>, ft::pool_allocator<ft::pair<const int, int> > > >,
+		mapClear<std::map<int, int, std::less<int>, ft::pool_allocator<std::pair<const int, int> > > >);
+	addBenchmark(benchmarks, "interval_map", "overlaps",
+		intervalOverlaps<ft::interval_map<int, int> >,
+		intervalOverlaps<std::map<std::pair<int, int>, int> >);
+	addBenchmark(benchmarks, "persistent_map", "snapshot writes",
+		snapshotWrites<ft::persistent_map<int, int> >, snapshotWrites<std::map<int, int> >);
+	addBenchmark(benchmarks, "persistent_map", "insert",
+		mapInsert<ft::persistent_map<int, int> >, mapInsert<std::map<int, int> >);
+	addBenchmark(benchmarks, "flat_map", "bulk insert",
+		mapBulkInsert<ft::flat_map<int, int> >, mapBulkInsert<std::map<int, int> >);
+	addBenchmark(benchmarks, "flat_map", "find",
+		mapBulkFind<ft::flat_map<int, int> >, mapBulkFind<std::map<int, int> >);
+	addBenchmark(benchmarks, "flat_map", "copy",
+		mapCopy<ft::flat_map<int, int> >, mapCopy<std::map<int, int> >);
+	addBenchmark(benchmarks, "unordered_map", "insert",
+		mapInsert<ft::unordered_map<int, int> >, mapInsert<std::tr1::unordered_map<int, int> >);
+	addBenchmark(benchmarks, "unordered_map", "erase",
+		mapErase<ft::unordered_map<int, int> >, mapErase<std::tr1::unordered_map<int, int> >);
+	addBenchmark(benchmarks, "unordered_map", "find",
+		mapFind<ft::unordered_map<int, int> >, mapFind<std::tr1::unordered_map<int, int> >);
+	addBenchmark(benchmarks, "unordered_map", "iterate",
+		mapIterate<ft::unordered_map<int, int> >, mapIterate<std::tr1::unordered_map<int, int> >);
+	addBenchmark(benchmarks, "unordered_map", "copy",
+		mapCopy<ft::unordered_map<int, int> >, mapCopy<std::tr1::unordered_map<int, int> >);
+	addBenchmark(benchmarks, "flat_hash_map", "find 0.5",
+		mapLoadFind<ft::flat_hash_map<int, int>, 500>,
+		mapLoadFind<std::tr1::unordered_map<int, int>, 500>);
+	addBenchmark(benchmarks, "flat_hash_map", "find 0.625",
+		mapLoadFind<ft::flat_hash_map<int, int>, 625>,
+		mapLoadFind<std::tr1::unordered_map<int, int>, 625>);
+	addBenchmark(benchmarks, "flat_hash_map", "find 0.75",
+		mapLoadFind<ft::flat_hash_map<int, int>, 750>,
+		mapLoadFind<std::tr1::unordered_map<int, int>, 750>);
+	addBenchmark(benchmarks, "flat_hash_map", "find 0.875",
+		mapLoadFind<ft::flat_hash_map<int, int>, 875>,
+		mapLoadFind<std::tr1::unordered_map<int, int>, 875>);
+	addBenchmark(benchmarks, "map", "find 0.5",
+		mapLoadFind<ft::map<int, int>, 500>, mapLoadFind<std::tr1::unordered_map<int, int>, 500>);
+	addBenchmark(benchmarks, "map", "find 0.875",
+		mapLoadFind<ft::map<int, int>, 875>, mapLoadFind<std::tr1::unordered_map<int, int>, 875>);
+	addBenchmark(benchmarks, "stack", "push",
+		adaptorPush<ft::stack<int> >, adaptorPush<std::stack<int> >);
+	addBenchmark(benchmarks, "stack", "pop",
+		adaptorPop<ft::stack<int> >, adaptorPop<std::stack<int> >);
+	addBenchmark(benchmarks, "queue", "push",
+		adaptorPush<ft::queue<int> >, adaptorPush<std::queue<int> >);
+	addBenchmark(benchmarks, "queue", "pop",
+		adaptorPop<ft::queue<int> >, adaptorPop<std::queue<int> >);
+	addBenchmark(benchmarks, "spsc_queue", "transfer",
+		queueTransfer<ft::spsc_queue<long, 1024> >, queueTransfer<MutexQueue<long, 1024> >);
+	addBenchmark(benchmarks, "mpmc_queue", "transfer 1x1",
+		queueThreads<ft::mpmc_queue<long, 1024>, 1, 1>, queueThreads<MutexQueue<long, 1024>, 1, 1>);
+	addBenchmark(benchmarks, "mpmc_queue", "transfer 2x2",
+		queueThreads<ft::mpmc_queue<long, 1024>, 2, 2>, queueThreads<MutexQueue<long, 1024>, 2, 2>);
+	addBenchmark(benchmarks, "mpmc_queue", "transfer 4x1",
+		queueThreads<ft::mpmc_queue<long, 1024>, 4, 1>, queueThreads<MutexQueue<long, 1024>, 4, 1>);
+	addBenchmark(benchmarks, "mpmc_queue", "transfer 1x4",
+		queueThreads<ft::mpmc_queue<long, 1024>, 1, 4>, queueThreads<MutexQueue<long, 1024>, 1, 4>);
+	addBenchmark(benchmarks, "mpmc_queue", "transfer 4x4",
+		queueThreads<ft::mpmc_queue<long, 1024>, 4, 4>, queueThreads<MutexQueue<long, 1024>, 4, 4>);
+	addBenchmark(benchmarks, "mpmc_queue", "transfer 8x8",
+		queueThreads<ft::mpmc_queue<long, 1024>, 8, 8>, queueThreads<MutexQueue<long, 1024>, 8, 8>);
+	addBenchmark(benchmarks, "lockfree_stack", "pool 1",
+		stackPool<ft::lockfree_stack<long>, 1>, stackPool<MutexStack<long>, 1>);
+	addBenchmark(benchmarks, "lockfree_stack", "pool 4",
+		stackPool<ft::lockfree_stack<long>, 4>, stackPool<MutexStack<long>, 4>);
+	addBenchmark(benchmarks, "lockfree_stack", "pool 32",
+		stackPool<ft::lockfree_stack<long>, 32>, stackPool<MutexStack<long>, 32>);
+
+	std::cout << std::fixed;
+	std::cout.precision(1);
+	if (options.json)
+		std::cout << "[" << std::endl;
+	else
+	{
+		std::cout << "container,operation,implementation,size,repetitions,";
+		std::cout << "median_ns,p99_ns,min_ns,mean_ns,median_ns_per_item" << std::endl;
+	}
+	first = true;
+	for (std::size_t i = 0; i < benchmarks.size(); i++)
+	{
+		if ((benchmarks[i].container + "/" + benchmarks[i].operation).find(options.filter) == std::string::npos)
+			continue ;
+		for (std::size_t j = 0; j < options.sizes.size(); j++)
+		{
+			printResult(benchmarks[i], options.sizes[j],
+				runBenchmark(benchmarks[i], options.sizes[j], options), options, first);
+			first = false;
+		}
+	}
+	if (options.json)
+		std::cout << "]" << std::endl;
+	return 0;
+}
@@ -0,0 +1,236 @@
+#ifndef DEQUEITERATOR_HPP
+# define DEQUEITERATOR_HPP
+
+# include <cstddef>					// size_t
+# include "Iterator.hpp"			// Extending base Iterator
+# include "iterator_traits.hpp"		// random_access_iterator_tag
+
+namespace ft
+{
+	// The amount of elements in a single block of a deque. Blocks are about
+	// 4 KiB, but always hold at least 16 elements.
+	template <class T>
+	struct deque_block_size
+	{
+		static const std::size_t	value = (sizeof(T) < 256) ? 4096 / sizeof(T) : 16;
+	};
+
+	// An iterator over the blocks of a deque. Besides the element it points to,
+	// it knows the slot in the block map of the block that the element is in,
+	// so it can step from one block to the next.
+	// It extends the base Iterator rather than RandomAccessIterator. That one
+	// does all of its arithmetic and comparisons on the element pointer alone,
+	// which can't step from one block to another, and it always points to
+	// elements that aren't const, so the const iterator of a deque couldn't
+	// keep its elements const.
+	template <class T, class Pointer = T*, class Reference = T&>
+	class DequeIterator : public Iterator<ft::random_access_iterator_tag, T, Pointer, Reference>
+	{
+		public:
+			// Iterator traits
+			typedef Iterator<ft::random_access_iterator_tag, T, Pointer, Reference>	base_iterator;
+			typedef T															value_type;
+			typedef typename base_iterator::difference_type						difference_type;
+			typedef typename base_iterator::pointer								pointer;
+			typedef typename base_iterator::reference							reference;
+			typedef typename base_iterator::iterator_category					iterator_category;
+			typedef DequeIterator<T, T*, T&>									iterator;
+			typedef DequeIterator<T, const T*, const T&>						const_iterator;
+			typedef T															**map_pointer;
+
+			// Default constructor
+			DequeIterator() : base_iterator(), _block(0)
+			{
+			}
+			// Parameterized constructor
+			DequeIterator(pointer ptr, map_pointer block) : base_iterator(ptr), _block(block)
+			{
+			}
+			// Copy constructor
+			DequeIterator(DequeIterator const &src) : base_iterator(src)
+			{
+				*this = src;
+			}
+			// Destructor
+			virtual ~DequeIterator()
+			{
+			}
+			// Assignment operator overload
+			DequeIterator	&operator=(DequeIterator const &src)
+			{
+				base_iterator::operator=(src);
+				this->_block = src._block;
+				return *this;
+			}
+			// * operator
+			reference		operator*() const
+			{
+				return *this->_ptr;
+			}
+			// -> operator
+			pointer			operator->() const
+			{
+				return this->_ptr;
+			}
+			// Prefix increment
+			DequeIterator	&operator++()
+			{
+				this->_ptr++;
+				if (this->_ptr == *this->_block + _blockSize())
+				{
+					this->_block++;
+					this->_ptr = *this->_block;
+				}
+				return *this;
+			}
+			// Postfix increment
+			DequeIterator	operator++(int)
+			{
+				DequeIterator	tmp(*this);
+				++(*this);
+				return tmp;
+			}
+			// Prefix decrement
+			DequeIterator	&operator--()
+			{
+				if (this->_ptr == *this->_block)
+				{
+					this->_block--;
+					this->_ptr = *this->_block + _blockSize();
+				}
+				this->_ptr--;
+				return *this;
+			}
+			// Postfix decrement
+			DequeIterator	operator--(int)
+			{
+				DequeIterator	tmp(*this);
+				--(*this);
+				return tmp;
+			}
+			// += operator
+			DequeIterator	&operator+=(difference_type n)
+			{
+				difference_type		offset;
+				difference_type		blocks;
+
+				offset = n + (this->_ptr - *this->_block);
+				if (offset >= 0 && offset < _blockSize())
+				{
+					this->_ptr += n;
+					return *this;
+				}
+				if (offset > 0)
+					blocks = offset / _blockSize();
+				else
+					blocks = -((-offset - 1) / _blockSize()) - 1;
+				this->_block += blocks;
+				this->_ptr = *this->_block + (offset - blocks * _blockSize());
+				return *this;
+			}
+			// -= operator
+			DequeIterator	&operator-=(difference_type n)
+			{
+				return *this += -n;
+			}
+			// + operator
+			DequeIterator	operator+(difference_type n) const
+			{
+				DequeIterator	tmp(*this);
+				return tmp += n;
+			}
+			// - operator (iterator - number)
+			DequeIterator	operator-(difference_type n) const
+			{
+				DequeIterator	tmp(*this);
+				return tmp -= n;
+			}
+			// [] operator
+			reference		operator[](difference_type n) const
+			{
+				return *(*this + n);
+			}
+			// Returns the slot in the block map that this iterator is in.
+			map_pointer		block() const
+			{
+				return this->_block;
+			}
+			// Returns the element this iterator points to.
+			pointer			ptr() const
+			{
+				return this->_ptr;
+			}
+
+			// Implicit conversion function to const version
+			operator	const_iterator() const
+			{
+				return const_iterator(this->_ptr, this->_block);
+			}
+
+		private:
+			map_pointer		_block;
+
+			// The amount of elements in every block.
+			static difference_type	_blockSize()
+			{
+				return deque_block_size<T>::value;
+			}
+	};
+
+	// - operator (iterator - iterator)
+	template <class T, class P1, class R1, class P2, class R2>
+	typename DequeIterator<T, P1, R1>::difference_type
+		operator-(const DequeIterator<T, P1, R1> &a, const DequeIterator<T, P2, R2> &b)
+	{
+		typename DequeIterator<T, P1, R1>::difference_type	blockSize = deque_block_size<T>::value;
+
+		return blockSize * (a.block() - b.block()) + (a.ptr() - *a.block()) - (b.ptr() - *b.block());
+	}
+	// == operator
+	template <class T, class P1, class R1, class P2, class R2>
+	bool		operator==(const DequeIterator<T, P1, R1> &a, const DequeIterator<T, P2, R2> &b)
+	{
+		return (a.ptr() == b.ptr());
+	}
+	// != operator
+	template <class T, class P1, class R1, class P2, class R2>
+	bool		operator!=(const DequeIterator<T, P1, R1> &a, const DequeIterator<T, P2, R2> &b)
+	{
+		return (a.ptr() != b.ptr());
+	}
+	// < operator
+	template <class T, class P1, class R1, class P2, class R2>
+	bool		operator<(const DequeIterator<T, P1, R1> &a, const DequeIterator<T, P2, R2> &b)
+	{
+		if (a.block() == b.block())
+			return (a.ptr() < b.ptr());
+		return (a.block() < b.block());
+	}
+	// > operator
+	template <class T, class P1, class R1, class P2, class R2>
+	bool		operator>(const DequeIterator<T, P1, R1> &a, const DequeIterator<T, P2, R2> &b)
+	{
+		return (b < a);
+	}
+	// <= operator
+	template <class T, class P1, class R1, class P2, class R2>
+	bool		operator<=(const DequeIterator<T, P1, R1> &a, const DequeIterator<T, P2, R2> &b)
+	{
+		return !(b < a);
+	}
+	// >= operator
+	template <class T, class P1, class R1, class P2, class R2>
+	bool		operator>=(const DequeIterator<T, P1, R1> &a, const DequeIterator<T, P2, R2> &b)
+	{
+		return !(a < b);
+	}
+	// Overload for number + DequeIterator
+	template <class T, class P, class R>
+	DequeIterator<T, P, R>	operator+(typename DequeIterator<T, P, R>::difference_type n,
+			DequeIterator<T, P, R> it)
+	{
+		return it + n;
+	}
+}
+
+#endif
@@ -0,0 +1,237 @@
+#ifndef FLATMAPITERATOR_HPP
+# define FLATMAPITERATOR_HPP
+
+# include <cstddef>					// ptrdiff_t
+# include "iterator_traits.hpp"		// random_access_iterator_tag
+# include "pair.hpp"				// pair class
+
+namespace ft
+{
+	// A flat map keeps its keys and its values in two separate arrays, so
+	// there is no pair in memory that an iterator could point to. Instead,
+	// dereferencing an iterator gives this pair of references, which has the
+	// same first and second members as the pair in a map.
+	template <class Key, class Mapped>
+	struct flat_map_reference
+	{
+		// Parameterized constructor
+		flat_map_reference(const Key &key, Mapped &value) : first(key), second(value)
+		{
+		}
+		// Conversion to a pair with copies of the key and value.
+		template <class K, class V>
+		operator	ft::pair<K, V>() const
+		{
+			return ft::pair<K, V>(this->first, this->second);
+		}
+
+		const Key		&first;
+		Mapped			&second;
+	};
+
+	// What operator-> of a flat map iterator returns. It holds the pair of
+	// references, so it->first and it->second work like they do on a map.
+	template <class Reference>
+	struct flat_map_pointer
+	{
+		// Parameterized constructor
+		flat_map_pointer(const Reference &ref) : _ref(ref)
+		{
+		}
+		// -> operator
+		Reference	*operator->()
+		{
+			return &this->_ref;
+		}
+
+		private:
+			Reference	_ref;
+	};
+
+	// An iterator over a flat map. It points to a key and to its value, and
+	// moves both of them together. Mapped is T for an iterator, and const T for
+	// a const_iterator.
+	template <class Key, class T, class Mapped>
+	class FlatMapIterator
+	{
+		public:
+			// Iterator traits
+			typedef ft::pair<const Key, T>								value_type;
+			typedef std::ptrdiff_t										difference_type;
+			typedef flat_map_reference<Key, Mapped>						reference;
+			typedef flat_map_pointer<reference>							pointer;
+			typedef ft::random_access_iterator_tag						iterator_category;
+			typedef FlatMapIterator<Key, T, T>							iterator;
+			typedef FlatMapIterator<Key, T, const T>					const_iterator;
+
+			// Default constructor
+			FlatMapIterator() : _key(0), _value(0)
+			{
+			}
+			// Parameterized constructor
+			FlatMapIterator(const Key *key, Mapped *value) : _key(key), _value(value)
+			{
+			}
+			// Copy constructor
+			FlatMapIterator(FlatMapIterator const &src)
+			{
+				*this = src;
+			}
+			// Destructor
+			virtual ~FlatMapIterator()
+			{
+			}
+			// Assignment operator overload
+			FlatMapIterator	&operator=(FlatMapIterator const &src)
+			{
+				this->_key = src._key;
+				this->_value = src._value;
+				return *this;
+			}
+			// Key pointer
+			const Key		*key() const
+			{
+				return this->_key;
+			}
+			// Value pointer
+			Mapped			*value() const
+			{
+				return this->_value;
+			}
+			// * operator
+			reference		operator*() const
+			{
+				return reference(*this->_key, *this->_value);
+			}
+			// -> operator
+			pointer			operator->() const
+			{
+				return pointer(**this);
+			}
+			// Prefix increment
+			FlatMapIterator	&operator++()
+			{
+				this->_key++;
+				this->_value++;
+				return *this;
+			}
+			// Postfix increment
+			FlatMapIterator	operator++(int)
+			{
+				FlatMapIterator	tmp = *this;
+				++(*this);
+				return tmp;
+			}
+			// Prefix decrement
+			FlatMapIterator	&operator--()
+			{
+				this->_key--;
+				this->_value--;
+				return *this;
+			}
+			// Postfix decrement
+			FlatMapIterator	operator--(int)
+			{
+				FlatMapIterator	tmp = *this;
+				--(*this);
+				return tmp;
+			}
+			// += operator
+			FlatMapIterator	&operator+=(difference_type n)
+			{
+				this->_key += n;
+				this->_value += n;
+				return *this;
+			}
+			// -= operator
+			FlatMapIterator	&operator-=(difference_type n)
+			{
+				this->_key -= n;
+				this->_value -= n;
+				return *this;
+			}
+			// + operator
+			FlatMapIterator	operator+(difference_type n) const
+			{
+				return FlatMapIterator(this->_key + n, this->_value + n);
+			}
+			// - operator (iterator - number)
+			FlatMapIterator	operator-(difference_type n) const
+			{
+				return FlatMapIterator(this->_key - n, this->_value - n);
+			}
+			// [] operator
+			reference		operator[](difference_type n) const
+			{
+				return reference(this->_key[n], this->_value[n]);
+			}
+			// Const conversion function
+			operator		const_iterator() const
+			{
+				return const_iterator(this->_key, this->_value);
+			}
+
+		private:
+			const Key		*_key;
+			Mapped			*_value;
+	};
+
+	// - operator (iterator - iterator)
+	template <class Key, class T, class M1, class M2>
+	std::ptrdiff_t	operator-(const FlatMapIterator<Key, T, M1> &lhs,
+			const FlatMapIterator<Key, T, M2> &rhs)
+	{
+		return (lhs.key() - rhs.key());
+	}
+	// == operator
+	template <class Key, class T, class M1, class M2>
+	bool	operator==(const FlatMapIterator<Key, T, M1> &lhs,
+			const FlatMapIterator<Key, T, M2> &rhs)
+	{
+		return (lhs.key() == rhs.key());
+	}
+	// != operator
+	template <class Key, class T, class M1, class M2>
+	bool	operator!=(const FlatMapIterator<Key, T, M1> &lhs,
+			const FlatMapIterator<Key, T, M2> &rhs)
+	{
+		return (lhs.key() != rhs.key());
+	}
+	// < operator
+	template <class Key, class T, class M1, class M2>
+	bool	operator<(const FlatMapIterator<Key, T, M1> &lhs,
+			const FlatMapIterator<Key, T, M2> &rhs)
+	{
+		return (lhs.key() < rhs.key());
+	}
+	// <= operator
+	template <class Key, class T, class M1, class M2>
+	bool	operator<=(const FlatMapIterator<Key, T, M1> &lhs,
+			const FlatMapIterator<Key, T, M2> &rhs)
+	{
+		return (lhs.key() <= rhs.key());
+	}
+	// > operator
+	template <class Key, class T, class M1, class M2>
+	bool	operator>(const FlatMapIterator<Key, T, M1> &lhs,
+			const FlatMapIterator<Key, T, M2> &rhs)
+	{
+		return (lhs.key() > rhs.key());
+	}
+	// >= operator
+	template <class Key, class T, class M1, class M2>
+	bool	operator>=(const FlatMapIterator<Key, T, M1> &lhs,
+			const FlatMapIterator<Key, T, M2> &rhs)
+	{
+		return (lhs.key() >= rhs.key());
+	}
+	// number + iterator
+	template <class Key, class T, class Mapped>
+	FlatMapIterator<Key, T, Mapped>	operator+(std::ptrdiff_t n,
+			const FlatMapIterator<Key, T, Mapped> &it)
+	{
+		return it + n;
+	}
+}
+
+#endif
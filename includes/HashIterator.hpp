@@ -0,0 +1,124 @@
+#ifndef HASHITERATOR_HPP
+# define HASHITERATOR_HPP
+
+# include "Iterator.hpp"			// Extending base Iterator
+# include "iterator_traits.hpp"		// forward_iterator_tag
+
+namespace ft
+{
+	// An iterator over the slots of an open addressing hash table. Next to
+	// every slot, the table keeps a control byte, and the high bit of that
+	// byte is set if the slot is free. The iterator walks the slots and the
+	// control bytes together and skips the free slots. The table ends with a
+	// control byte that has the high bit cleared, or that is 0xFF, so the walk
+	// stops there.
+	template <class T, class Pointer = T*, class Reference = T&>
+	class HashIterator : public Iterator<ft::forward_iterator_tag, T, Pointer, Reference>
+	{
+		public:
+			// Iterator traits
+			typedef Iterator<ft::forward_iterator_tag, T, Pointer, Reference>	base_iterator;
+			typedef T															value_type;
+			typedef typename base_iterator::difference_type						difference_type;
+			typedef typename base_iterator::pointer								pointer;
+			typedef typename base_iterator::reference							reference;
+			typedef typename base_iterator::iterator_category					iterator_category;
+			typedef HashIterator<T, T*, T&>										iterator;
+			typedef HashIterator<T, const T*, const T&>							const_iterator;
+
+			// Default constructor
+			HashIterator() : base_iterator(), _control(0)
+			{
+			}
+			// Parameterized constructor. Moves on to the first used slot.
+			HashIterator(pointer slot, const unsigned char *control)
+				: base_iterator(slot), _control(control)
+			{
+				this->_skipFree();
+			}
+			// Copy constructor
+			HashIterator(HashIterator const &src) : base_iterator(src)
+			{
+				*this = src;
+			}
+			// Destructor
+			virtual ~HashIterator()
+			{
+			}
+			// Assignment operator overload
+			HashIterator	&operator=(HashIterator const &src)
+			{
+				base_iterator::operator=(src);
+				this->_control = src._control;
+				return *this;
+			}
+			// Slot
+			pointer			slot() const
+			{
+				return this->_ptr;
+			}
+			// Control byte
+			const unsigned char	*control() const
+			{
+				return this->_control;
+			}
+			// * operator
+			reference		operator*() const
+			{
+				return *this->_ptr;
+			}
+			// -> operator
+			pointer			operator->() const
+			{
+				return this->_ptr;
+			}
+			// Prefix increment
+			HashIterator	&operator++()
+			{
+				this->_ptr++;
+				this->_control++;
+				this->_skipFree();
+				return *this;
+			}
+			// Postfix increment
+			HashIterator	operator++(int)
+			{
+				HashIterator	tmp = *this;
+				++(*this);
+				return tmp;
+			}
+			// Const conversion function
+			operator		const_iterator() const
+			{
+				return const_iterator(this->_ptr, this->_control);
+			}
+
+		private:
+			const unsigned char		*_control;
+
+			// This function moves on until the slot is used.
+			void			_skipFree()
+			{
+				while ((*this->_control & 0x80) && *this->_control != 0xFF)
+				{
+					this->_ptr++;
+					this->_control++;
+				}
+			}
+	};
+
+	// == operator
+	template <class T, class P1, class R1, class P2, class R2>
+	bool	operator==(const HashIterator<T, P1, R1> &lhs, const HashIterator<T, P2, R2> &rhs)
+	{
+		return (lhs.control() == rhs.control());
+	}
+	// != operator
+	template <class T, class P1, class R1, class P2, class R2>
+	bool	operator!=(const HashIterator<T, P1, R1> &lhs, const HashIterator<T, P2, R2> &rhs)
+	{
+		return (lhs.control() != rhs.control());
+	}
+}
+
+#endif
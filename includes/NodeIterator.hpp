@@ -79,6 +79,11 @@ namespace ft
 				--(*this);
 				return tmp;
 			}
+			// Returns the node this iterator points to.
+			Node				*node() const
+			{
+				return this->_ptr;
+			}
 			// Implicit conversion function to const version
 			operator	NodeIterator<const Node, const T>() const
 			{
@@ -0,0 +1,129 @@
+#ifndef PERSISTENTITERATOR_HPP
+# define PERSISTENTITERATOR_HPP
+
+# include "Iterator.hpp"			// Extending base Iterator
+# include "iterator_traits.hpp"		// forward_iterator_tag
+
+namespace ft
+{
+	// An iterator over a persistent map. The nodes of a persistent map are
+	// shared between snapshots, so they can't point back to a parent: a node
+	// has a different parent in every snapshot. The iterator keeps the path
+	// down to its node instead, as a stack of the nodes it still has to visit.
+	// An AVL tree of 2^64 nodes is less than 93 levels deep, so the stack has
+	// a fixed size. Only the nodes are shared, so the elements can't be
+	// changed through an iterator.
+	template <class Node, class T>
+	class PersistentIterator : public Iterator<ft::forward_iterator_tag, T, const T*, const T&>
+	{
+		public:
+			// Iterator traits
+			typedef Iterator<ft::forward_iterator_tag, T, const T*, const T&>	base_iterator;
+			typedef T															value_type;
+			typedef typename base_iterator::difference_type						difference_type;
+			typedef typename base_iterator::pointer								pointer;
+			typedef typename base_iterator::reference							reference;
+			typedef typename base_iterator::iterator_category					iterator_category;
+
+			// The most nodes the path can hold.
+			static const int	max_depth = 96;
+
+			// Default constructor. The end of any map.
+			PersistentIterator() : base_iterator(), _depth(0)
+			{
+			}
+			// Copy constructor
+			PersistentIterator(PersistentIterator const &src) : base_iterator(src)
+			{
+				*this = src;
+			}
+			// Destructor
+			virtual ~PersistentIterator()
+			{
+			}
+			// Assignment operator overload
+			PersistentIterator	&operator=(PersistentIterator const &src)
+			{
+				int		i;
+
+				base_iterator::operator=(src);
+				this->_depth = src._depth;
+				for (i = 0; i < this->_depth; i++)
+					this->_path[i] = src._path[i];
+				return *this;
+			}
+			// Node. The node the iterator is at, 0 at the end.
+			const Node		*node() const
+			{
+				if (this->_depth == 0)
+					return 0;
+				return this->_path[this->_depth - 1];
+			}
+			// Push. Adds a node that comes after the ones already on the path,
+			// in order. The map builds a path with this, from the root down.
+			void			push(const Node *node)
+			{
+				this->_path[this->_depth++] = node;
+				this->_ptr = &node->data;
+			}
+			// Push left. Pushes node, and the nodes down its left side.
+			void			push_left(const Node *node)
+			{
+				while (node)
+				{
+					this->push(node);
+					node = node->left;
+				}
+			}
+			// * operator
+			reference		operator*() const
+			{
+				return *this->_ptr;
+			}
+			// -> operator
+			pointer			operator->() const
+			{
+				return this->_ptr;
+			}
+			// Prefix increment. Everything on the right of the node comes next,
+			// starting with the leftmost node over there.
+			PersistentIterator	&operator++()
+			{
+				const Node		*right;
+
+				right = this->_path[--this->_depth]->right;
+				this->push_left(right);
+				if (this->_depth == 0)
+					this->_ptr = 0;
+				else
+					this->_ptr = &this->_path[this->_depth - 1]->data;
+				return *this;
+			}
+			// Postfix increment
+			PersistentIterator	operator++(int)
+			{
+				PersistentIterator	tmp = *this;
+				++(*this);
+				return tmp;
+			}
+
+		private:
+			const Node		*_path[max_depth];
+			int				_depth;
+	};
+
+	// == operator
+	template <class Node, class T>
+	bool	operator==(const PersistentIterator<Node, T> &lhs, const PersistentIterator<Node, T> &rhs)
+	{
+		return (lhs.node() == rhs.node());
+	}
+	// != operator
+	template <class Node, class T>
+	bool	operator!=(const PersistentIterator<Node, T> &lhs, const PersistentIterator<Node, T> &rhs)
+	{
+		return (lhs.node() != rhs.node());
+	}
+}
+
+#endif
@@ -56,10 +56,12 @@ namespace ft
 				Iterator	tmp = this->_base;
 				return *--tmp;
 			}
-			// -> operator overload
+			// -> operator overload. Goes through the -> operator of the base, so
+			// it also works for iterators whose pointer is not a plain pointer.
 			pointer				operator->()
 			{
-				return (&(operator*()));
+				Iterator	tmp = this->_base;
+				return (--tmp).operator->();
 			}
 			// + operator overload
 			ReverseIterator		operator+(difference_type n)
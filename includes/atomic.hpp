@@ -0,0 +1,69 @@
+#ifndef ATOMIC_HPP
+# define ATOMIC_HPP
+
+# include <cstddef>				// size_t
+
+namespace ft
+{
+	// C++98 has no atomics, so the concurrent containers use the __atomic
+	// builtins that gcc and clang provide in every language mode. These
+	// functions only give them shorter names.
+
+	// The size of a cache line. Data that different threads write to is kept
+	// this far apart, so the threads don't keep stealing the line from each
+	// other.
+	static const std::size_t	cache_line_size = 64;
+
+	// Memory orders
+	enum memory_order
+	{
+		memory_order_relaxed = __ATOMIC_RELAXED,
+		memory_order_acquire = __ATOMIC_ACQUIRE,
+		memory_order_release = __ATOMIC_RELEASE,
+		memory_order_acq_rel = __ATOMIC_ACQ_REL,
+		memory_order_seq_cst = __ATOMIC_SEQ_CST
+	};
+
+	// Load
+	template <class T>
+	T		atomic_load(const T *ptr, memory_order order)
+	{
+		return __atomic_load_n(ptr, order);
+	}
+	// Store
+	template <class T>
+	void	atomic_store(T *ptr, T val, memory_order order)
+	{
+		__atomic_store_n(ptr, val, order);
+	}
+	// Fetch add
+	template <class T>
+	T		atomic_fetch_add(T *ptr, T val, memory_order order)
+	{
+		return __atomic_fetch_add(ptr, val, order);
+	}
+	// Compare exchange (weak). On failure, expected is set to the current value.
+	template <class T>
+	bool	atomic_compare_exchange(T *ptr, T &expected, T desired,
+				memory_order success, memory_order failure)
+	{
+		return __atomic_compare_exchange_n(ptr, &expected, desired, true, success, failure);
+	}
+	// Fence
+	inline void	atomic_thread_fence(memory_order order)
+	{
+		__atomic_thread_fence(order);
+	}
+	// Tells the processor that this thread is spinning, so it can save power
+	// and give its resources to the other hardware thread on the core.
+	inline void	cpu_relax()
+	{
+#if defined(__i386__) || defined(__x86_64__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__)
+		__asm__ __volatile__("yield");
+#endif
+	}
+}
+
+#endif
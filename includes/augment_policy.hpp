@@ -0,0 +1,62 @@
+#ifndef AUGMENT_POLICY_HPP
+# define AUGMENT_POLICY_HPP
+
+# include <cstddef>				// size_t
+
+namespace ft
+{
+	// Augment policies add data to every node of a map, which the map keeps
+	// up to date whenever the tree below a node changes. Every node inherits
+	// the node_data of the policy, and update computes it again from the
+	// children of a node, after their own data is up to date. Update also
+	// gets the key compare of the map, for data that depends on the order.
+	// Enabled tells the map if there is anything to keep up to date at all.
+
+	// No extra data. The nodes stay as small as they were.
+	struct no_augment
+	{
+		static const bool	enabled = false;
+
+		struct node_data
+		{
+		};
+
+		template <class Node, class Compare>
+		static void		update(Node &, const Compare &)
+		{
+		}
+	};
+
+	// Every node knows the amount of nodes in its subtree, so the map can
+	// find the element at a position, or the position of a key, by walking
+	// down the tree once.
+	struct order_statistics
+	{
+		static const bool	enabled = true;
+
+		struct node_data
+		{
+			node_data() : subtreeSize(1)
+			{
+			}
+
+			std::size_t		subtreeSize;
+		};
+
+		template <class Node, class Compare>
+		static void		update(Node &node, const Compare &)
+		{
+			node.subtreeSize = 1 + size(node.left) + size(node.right);
+		}
+		// The amount of nodes in a subtree, 0 for an empty one.
+		template <class Node>
+		static std::size_t	size(const Node *node)
+		{
+			if (node == 0)
+				return 0;
+			return node->subtreeSize;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,565 @@
+#ifndef DEQUE_HPP
+# define DEQUE_HPP
+
+# include <cstddef>						// size_t, ptrdiff_t
+# include <memory>						// allocator
+# include <stdexcept>					// out_of_range exception
+# include "DequeIterator.hpp"			// DequeIterator class
+# include "ReverseIterator.hpp"			// ReverseIterator class
+# include "iterator_traits.hpp"			// Iterator traits
+# include "utils.hpp"					// Swap, lexicographical_compare
+
+namespace ft
+{
+	// The elements of a deque live in fixed-size blocks, which are never moved
+	// or reallocated. A map of block pointers keeps the blocks in order. Only
+	// that map is reallocated when it runs out of room at one of its ends, so
+	// adding or removing elements at either end takes constant time.
+	// The blocks from the block of the first element up to and including the
+	// block of the end iterator are allocated, so the end iterator always
+	// points into a block.
+	template <class T, class Alloc = std::allocator<T> >
+	class deque
+	{
+		//////////////////
+		// MEMBER TYPES //
+		//////////////////
+		public:
+			typedef T															value_type;
+			typedef Alloc														allocator_type;
+			typedef typename allocator_type::reference							reference;
+			typedef typename allocator_type::const_reference					const_reference;
+			typedef typename allocator_type::pointer							pointer;
+			typedef typename allocator_type::const_pointer						const_pointer;
+			typedef DequeIterator<T, T*, T&>									iterator;
+			typedef DequeIterator<T, const T*, const T&>						const_iterator;
+			typedef ReverseIterator<iterator>									reverse_iterator;
+			typedef ReverseIterator<const_iterator>								const_reverse_iterator;
+			typedef std::ptrdiff_t												difference_type;
+			typedef std::size_t													size_type;
+			typedef typename allocator_type::template rebind<T*>::other		MapAlloc;
+
+		//////////////////////
+		// MEMBER FUNCTIONS //
+		//////////////////////
+		public:
+			//////////////////
+			// CONSTRUCTORS //
+			//////////////////
+			// Default constructor
+			explicit deque(const allocator_type &alloc = allocator_type())
+				: _allocator(alloc), _mapAllocator(alloc), _map(0), _mapSize(0)
+			{
+				this->_initializeMap();
+			}
+			// Fill constructor
+			explicit deque(size_type n, const value_type &val = value_type(),
+					const allocator_type &alloc = allocator_type())
+				: _allocator(alloc), _mapAllocator(alloc), _map(0), _mapSize(0)
+			{
+				this->_initializeMap();
+				this->assign(n, val);
+			}
+			// Range constructor
+			template <class InputIterator>
+			deque(InputIterator first, InputIterator last,
+					const allocator_type &alloc = allocator_type(),
+					typename ft::iterator_traits<InputIterator>::iterator_category* = 0)
+				: _allocator(alloc), _mapAllocator(alloc), _map(0), _mapSize(0)
+			{
+				this->_initializeMap();
+				this->assign(first, last);
+			}
+			// Copy constructor
+			deque(const deque &x)
+				: _allocator(x._allocator), _mapAllocator(x._mapAllocator), _map(0), _mapSize(0)
+			{
+				this->_initializeMap();
+				*this = x;
+			}
+			////////////////
+			// DESTRUCTOR //
+			////////////////
+			virtual ~deque()
+			{
+				this->clear();
+				this->_allocator.deallocate(*this->_start.block(), _blockSize());
+				this->_mapAllocator.deallocate(this->_map, this->_mapSize);
+			}
+
+			/////////////////////////
+			// ASSIGNMENT OVERLOAD //
+			/////////////////////////
+			deque	&operator=(const deque &x)
+			{
+				if (this != &x)
+					this->assign(x.begin(), x.end());
+				return *this;
+			}
+
+			///////////////
+			// ITERATORS //
+			///////////////
+			// Begin
+			iterator				begin()
+			{
+				return this->_start;
+			}
+			// Begin (const)
+			const_iterator			begin() const
+			{
+				return this->_start;
+			}
+			// End
+			iterator				end()
+			{
+				return this->_finish;
+			}
+			// End (const)
+			const_iterator			end() const
+			{
+				return this->_finish;
+			}
+			// Reverse begin
+			reverse_iterator		rbegin()
+			{
+				return reverse_iterator(this->end());
+			}
+			// Reverse begin (const)
+			const_reverse_iterator	rbegin() const
+			{
+				return const_reverse_iterator(this->end());
+			}
+			// Reverse end
+			reverse_iterator		rend()
+			{
+				return reverse_iterator(this->begin());
+			}
+			// Reverse end (const)
+			const_reverse_iterator	rend() const
+			{
+				return const_reverse_iterator(this->begin());
+			}
+
+			//////////////
+			// CAPACITY //
+			//////////////
+			// Size
+			size_type		size() const
+			{
+				return this->_finish - this->_start;
+			}
+			// Max size
+			size_type		max_size() const
+			{
+				return this->_allocator.max_size();
+			}
+			// Resize
+			void			resize(size_type n, value_type val = value_type())
+			{
+				while (this->size() > n)
+					this->pop_back();
+				while (this->size() < n)
+					this->push_back(val);
+			}
+			// Empty
+			bool			empty() const
+			{
+				return (this->_start == this->_finish);
+			}
+
+			////////////////////
+			// ELEMENT ACCESS //
+			////////////////////
+			// Operator [] overload
+			reference			operator[](size_type n)
+			{
+				return this->_start[n];
+			}
+			// Operator [] overload (const)
+			const_reference		operator[](size_type n) const
+			{
+				return this->_start[n];
+			}
+			// At
+			reference			at(size_type n)
+			{
+				if (n >= this->size())
+					throw std::out_of_range("deque");
+				return this->_start[n];
+			}
+			// At (const)
+			const_reference		at(size_type n) const
+			{
+				if (n >= this->size())
+					throw std::out_of_range("deque");
+				return this->_start[n];
+			}
+			// Front
+			reference			front()
+			{
+				return *this->_start;
+			}
+			// Front (const)
+			const_reference		front() const
+			{
+				return *this->_start;
+			}
+			// Back
+			reference			back()
+			{
+				return *(this->_finish - 1);
+			}
+			// Back (const)
+			const_reference		back() const
+			{
+				return *(this->_finish - 1);
+			}
+
+			///////////////
+			// MODIFIERS //
+			///////////////
+			// Assign (range)
+			template <class InputIterator>
+			void		assign(InputIterator first, InputIterator last,
+					typename ft::iterator_traits<InputIterator>::iterator_category* = 0)
+			{
+				this->clear();
+				for (; first != last; first++)
+					this->push_back(*first);
+			}
+			// Assign (fill)
+			void		assign(size_type n, const value_type &val)
+			{
+				this->clear();
+				for (size_type i = 0; i < n; i++)
+					this->push_back(val);
+			}
+			// Push back
+			void		push_back(const value_type &val)
+			{
+				pointer		last;
+
+				last = *this->_finish.block() + _blockSize() - 1;
+				if (this->_finish.ptr() != last)
+				{
+					this->_allocator.construct(this->_finish.ptr(), val);
+					this->_finish = iterator(this->_finish.ptr() + 1, this->_finish.block());
+					return ;
+				}
+				// The last slot of the block is used, so the end moves to a new block.
+				this->_reserveMapAtBack();
+				*(this->_finish.block() + 1) = this->_allocator.allocate(_blockSize());
+				this->_allocator.construct(this->_finish.ptr(), val);
+				this->_finish = iterator(*(this->_finish.block() + 1), this->_finish.block() + 1);
+			}
+			// Push front
+			void		push_front(const value_type &val)
+			{
+				if (this->_start.ptr() != *this->_start.block())
+				{
+					this->_allocator.construct(this->_start.ptr() - 1, val);
+					this->_start = iterator(this->_start.ptr() - 1, this->_start.block());
+					return ;
+				}
+				this->_reserveMapAtFront();
+				*(this->_start.block() - 1) = this->_allocator.allocate(_blockSize());
+				this->_start = iterator(*(this->_start.block() - 1) + _blockSize() - 1,
+						this->_start.block() - 1);
+				this->_allocator.construct(this->_start.ptr(), val);
+			}
+			// Pop back
+			void		pop_back()
+			{
+				if (this->_finish.ptr() == *this->_finish.block())
+				{
+					this->_allocator.deallocate(this->_finish.ptr(), _blockSize());
+					this->_finish = iterator(*(this->_finish.block() - 1) + _blockSize(),
+							this->_finish.block() - 1);
+				}
+				this->_finish = iterator(this->_finish.ptr() - 1, this->_finish.block());
+				this->_allocator.destroy(this->_finish.ptr());
+			}
+			// Pop front
+			void		pop_front()
+			{
+				this->_allocator.destroy(this->_start.ptr());
+				if (this->_start.ptr() != *this->_start.block() + _blockSize() - 1)
+				{
+					this->_start = iterator(this->_start.ptr() + 1, this->_start.block());
+					return ;
+				}
+				this->_allocator.deallocate(*this->_start.block(), _blockSize());
+				this->_start = iterator(*(this->_start.block() + 1), this->_start.block() + 1);
+			}
+			// Insert (single element)
+			iterator	insert(iterator position, const value_type &val)
+			{
+				difference_type		pos = position - this->begin();
+
+				this->insert(position, 1, val);
+				return this->begin() + pos;
+			}
+			// Insert (fill)
+			void		insert(iterator position, size_type n, const value_type &val)
+			{
+				difference_type		pos = position - this->begin();
+				value_type			copy(val);
+
+				if (n == 0)
+					return ;
+				this->_openGap(pos, n, copy);
+				for (size_type i = 0; i < n; i++)
+					(*this)[pos + i] = copy;
+			}
+			// Insert (range)
+			template <class InputIterator>
+			void		insert(iterator position, InputIterator first, InputIterator last,
+					typename ft::iterator_traits<InputIterator>::iterator_category* = 0)
+			{
+				difference_type		pos = position - this->begin();
+				size_type			n = ft::distance(first, last);
+
+				if (n == 0)
+					return ;
+				this->_openGap(pos, n, *first);
+				for (size_type i = 0; first != last; first++, i++)
+					(*this)[pos + i] = *first;
+			}
+			// Erase (single element)
+			iterator	erase(iterator position)
+			{
+				return this->erase(position, position + 1);
+			}
+			// Erase (range)
+			// The elements on the shorter side of the range are moved over it, and
+			// the leftover elements at that end are popped.
+			iterator	erase(iterator first, iterator last)
+			{
+				difference_type		pos = first - this->begin();
+				difference_type		n = last - first;
+				difference_type		size = this->size();
+
+				if (n == 0)
+					return first;
+				if (pos < (size - n) / 2)
+				{
+					for (difference_type i = pos - 1; i >= 0; i--)
+						(*this)[i + n] = (*this)[i];
+					for (difference_type i = 0; i < n; i++)
+						this->pop_front();
+				}
+				else
+				{
+					for (difference_type i = pos + n; i < size; i++)
+						(*this)[i - n] = (*this)[i];
+					for (difference_type i = 0; i < n; i++)
+						this->pop_back();
+				}
+				return this->begin() + pos;
+			}
+			// Swap
+			void		swap(deque &x)
+			{
+				ft::swap(this->_map, x._map);
+				ft::swap(this->_mapSize, x._mapSize);
+				ft::swap(this->_start, x._start);
+				ft::swap(this->_finish, x._finish);
+				ft::swap(this->_allocator, x._allocator);
+				ft::swap(this->_mapAllocator, x._mapAllocator);
+			}
+			// Clear
+			// Only the block that the first element was in is kept.
+			void		clear()
+			{
+				while (this->_finish.block() != this->_start.block())
+				{
+					for (pointer p = *this->_finish.block(); p != this->_finish.ptr(); p++)
+						this->_allocator.destroy(p);
+					this->_allocator.deallocate(*this->_finish.block(), _blockSize());
+					this->_finish = iterator(*(this->_finish.block() - 1) + _blockSize(),
+							this->_finish.block() - 1);
+				}
+				for (pointer p = this->_start.ptr(); p != this->_finish.ptr(); p++)
+					this->_allocator.destroy(p);
+				this->_finish = this->_start;
+			}
+
+			///////////////
+			// ALLOCATOR //
+			///////////////
+			// Get allocator
+			allocator_type	get_allocator() const
+			{
+				return this->_allocator;
+			}
+
+		///////////////////////
+		// PRIVATE VARIABLES //
+		///////////////////////
+		private:
+			allocator_type	_allocator;
+			MapAlloc		_mapAllocator;
+			T				**_map;
+			size_type		_mapSize;
+			iterator		_start;
+			iterator		_finish;
+
+		//////////////////////////////
+		// PRIVATE MEMBER FUNCTIONS //
+		//////////////////////////////
+		private:
+			// The amount of elements in every block.
+			static size_type	_blockSize()
+			{
+				return deque_block_size<T>::value;
+			}
+			// This function sets up a small map with a single block in the middle,
+			// so the deque can grow in both directions.
+			void	_initializeMap()
+			{
+				T		**block;
+
+				this->_mapSize = 8;
+				this->_map = this->_mapAllocator.allocate(this->_mapSize);
+				block = this->_map + this->_mapSize / 2;
+				*block = this->_allocator.allocate(_blockSize());
+				this->_start = iterator(*block, block);
+				this->_finish = this->_start;
+			}
+			// This function makes sure there is a free slot in the map after the
+			// block of the end iterator.
+			void	_reserveMapAtBack()
+			{
+				if (this->_finish.block() + 1 == this->_map + this->_mapSize)
+					this->_reallocateMap(false);
+			}
+			// This function makes sure there is a free slot in the map before the
+			// block of the first element.
+			void	_reserveMapAtFront()
+			{
+				if (this->_start.block() == this->_map)
+					this->_reallocateMap(true);
+			}
+			// This function makes room in the map for one more block, at the front
+			// or at the back. If the map is less than half full, the blocks are
+			// centered in it again. Otherwise, a map twice as big is allocated.
+			// Either way, only the block pointers are moved.
+			void	_reallocateMap(bool atFront)
+			{
+				size_type	usedBlocks;
+				size_type	newMapSize;
+				T			**newMap;
+				T			**newStart;
+
+				usedBlocks = this->_finish.block() - this->_start.block() + 1;
+				if (this->_mapSize > 2 * (usedBlocks + 1))
+				{
+					newMap = this->_map;
+					newMapSize = this->_mapSize;
+				}
+				else
+				{
+					newMapSize = this->_mapSize * 2;
+					newMap = this->_mapAllocator.allocate(newMapSize);
+				}
+				newStart = newMap + (newMapSize - usedBlocks - 1) / 2 + (atFront ? 1 : 0);
+				if (newStart < this->_start.block())
+				{
+					for (size_type i = 0; i < usedBlocks; i++)
+						newStart[i] = this->_start.block()[i];
+				}
+				else
+				{
+					for (size_type i = usedBlocks; i > 0; i--)
+						newStart[i - 1] = this->_start.block()[i - 1];
+				}
+				if (newMap != this->_map)
+				{
+					this->_mapAllocator.deallocate(this->_map, this->_mapSize);
+					this->_map = newMap;
+					this->_mapSize = newMapSize;
+				}
+				this->_start = iterator(this->_start.ptr(), newStart);
+				this->_finish = iterator(this->_finish.ptr(), newStart + usedBlocks - 1);
+			}
+			// This function opens a gap of n elements at index pos, by moving the
+			// elements on the shorter side of it outwards. The slots in the gap
+			// hold copies of val, or old elements, until they are assigned to.
+			void	_openGap(difference_type pos, size_type n, const value_type &val)
+			{
+				difference_type		size = this->size();
+
+				if (pos < size / 2)
+				{
+					for (size_type i = 0; i < n; i++)
+						this->push_front(val);
+					for (difference_type i = 0; i < pos; i++)
+						(*this)[i] = (*this)[i + n];
+				}
+				else
+				{
+					for (size_type i = 0; i < n; i++)
+						this->push_back(val);
+					for (difference_type i = size - 1; i >= pos; i--)
+						(*this)[i + n] = (*this)[i];
+				}
+			}
+	};
+
+	//////////////////////////
+	// RELATIONAL OPERATORS //
+	//////////////////////////
+	// == operator
+	template <class T, class Alloc>
+	bool		operator==(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs)
+	{
+		typename deque<T, Alloc>::const_iterator	lhsit = lhs.begin();
+		typename deque<T, Alloc>::const_iterator	rhsit = rhs.begin();
+
+		if (lhs.size() != rhs.size())
+			return false;
+		for (; lhsit != lhs.end(); lhsit++, rhsit++)
+			if (*lhsit != *rhsit)
+				return false;
+		return true;
+	}
+	// != operator
+	template <class T, class Alloc>
+	bool		operator!=(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs)
+	{
+		return !(lhs == rhs);
+	}
+	// < operator
+	template <class T, class Alloc>
+	bool		operator<(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs)
+	{
+		return lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+	// <= operator
+	template <class T, class Alloc>
+	bool		operator<=(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs)
+	{
+		return !(rhs < lhs);
+	}
+	// > operator
+	template <class T, class Alloc>
+	bool		operator>(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs)
+	{
+		return (rhs < lhs);
+	}
+	// >= operator
+	template <class T, class Alloc>
+	bool		operator>=(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs)
+	{
+		return !(lhs < rhs);
+	}
+	// Swap
+	template <class T, class Alloc>
+	void		swap(deque<T, Alloc> &x, deque<T, Alloc> &y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif
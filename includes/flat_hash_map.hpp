@@ -0,0 +1,358 @@
+#ifndef FLAT_HASH_MAP_HPP
+# define FLAT_HASH_MAP_HPP
+
+# include <cstddef>				// size_t, ptrdiff_t
+# include <memory>				// allocator
+# include "hash.hpp"			// hash, enable_transparent
+# include "pair.hpp"			// pair class
+# include "swiss_table.hpp"		// swiss_table class
+# include "utils.hpp"			// equal_to predicate, select_first
+
+namespace ft
+{
+	// A hash map on top of a swiss table (see swiss_table.hpp), which looks up
+	// a key by comparing a whole group of control bytes at once. It has the
+	// same find, insert and erase as ft::map, without the order.
+	template <class Key,
+			 class T,
+			 class Hash = ft::hash<Key>,
+			 class Pred = ft::equal_to<Key>,
+			 class Alloc = std::allocator<ft::pair<const Key, T> > >
+	class flat_hash_map
+	{
+		//////////////////
+		// MEMBER TYPES //
+		//////////////////
+		public:
+			typedef Key														key_type;
+			typedef T														mapped_type;
+			typedef ft::pair<const key_type, mapped_type>					value_type;
+			typedef Hash													hasher;
+			typedef Pred													key_equal;
+			typedef Alloc													allocator_type;
+			typedef typename allocator_type::reference						reference;
+			typedef typename allocator_type::const_reference				const_reference;
+			typedef typename allocator_type::pointer						pointer;
+			typedef typename allocator_type::const_pointer					const_pointer;
+			typedef swiss_table<value_type, key_type, ft::select_first<value_type>,
+					hasher, key_equal, allocator_type>						table_type;
+			typedef typename table_type::iterator							iterator;
+			typedef typename table_type::const_iterator						const_iterator;
+			typedef std::ptrdiff_t											difference_type;
+			typedef std::size_t												size_type;
+
+		//////////////////////
+		// MEMBER FUNCTIONS //
+		//////////////////////
+		public:
+			//////////////////
+			// CONSTRUCTORS //
+			//////////////////
+			// Default constructor
+			explicit flat_hash_map(size_type n = 0, const hasher &hf = hasher(),
+					const key_equal &eql = key_equal(),
+					const allocator_type &alloc = allocator_type())
+				: _table(hf, eql, alloc)
+			{
+				if (n != 0)
+					this->rehash(n);
+			}
+			// Range constructor
+			template <class InputIterator>
+			flat_hash_map(InputIterator first, InputIterator last, size_type n = 0,
+					const hasher &hf = hasher(), const key_equal &eql = key_equal(),
+					const allocator_type &alloc = allocator_type(),
+					typename ft::iterator_traits<InputIterator>::iterator_category* = 0)
+				: _table(hf, eql, alloc)
+			{
+				if (n != 0)
+					this->rehash(n);
+				this->insert(first, last);
+			}
+			// Copy constructor
+			flat_hash_map(const flat_hash_map &x) : _table(x._table)
+			{
+			}
+			////////////////
+			// DESTRUCTOR //
+			////////////////
+			virtual ~flat_hash_map()
+			{
+			}
+
+			/////////////////////////
+			// ASSIGNMENT OVERLOAD //
+			/////////////////////////
+			flat_hash_map	&operator=(const flat_hash_map &x)
+			{
+				this->_table = x._table;
+				return *this;
+			}
+
+			///////////////
+			// ITERATORS //
+			///////////////
+			// Begin
+			iterator		begin()
+			{
+				return this->_table.begin();
+			}
+			// Begin (const)
+			const_iterator	begin() const
+			{
+				return this->_table.begin();
+			}
+			// End
+			iterator		end()
+			{
+				return this->_table.end();
+			}
+			// End (const)
+			const_iterator	end() const
+			{
+				return this->_table.end();
+			}
+
+			//////////////
+			// CAPACITY //
+			//////////////
+			// Empty
+			bool		empty() const
+			{
+				return this->_table.empty();
+			}
+			// Size
+			size_type	size() const
+			{
+				return this->_table.size();
+			}
+			// Max size
+			size_type	max_size() const
+			{
+				return this->_table.max_size();
+			}
+
+			////////////////////
+			// ELEMENT ACCESS //
+			////////////////////
+			// Operator []
+			mapped_type		&operator[](const key_type &k)
+			{
+				iterator	it;
+
+				it = this->_table.find(k);
+				if (it == this->_table.end())
+					it = this->_table.insert(value_type(k, mapped_type())).first;
+				return it->second;
+			}
+
+			///////////////
+			// MODIFIERS //
+			///////////////
+			// Insert (Single element)
+			pair<iterator, bool>	insert(const value_type &val)
+			{
+				return this->_table.insert(val);
+			}
+			// Insert (With hint). The hint is of no use to a hash table.
+			iterator				insert(iterator, const value_type &val)
+			{
+				return this->_table.insert(val).first;
+			}
+			// Insert (Range)
+			template <class InputIterator>
+			void					insert(InputIterator first, InputIterator last,
+					typename ft::iterator_traits<InputIterator>::iterator_category* = 0)
+			{
+				while (first != last)
+				{
+					this->_table.insert(*first);
+					first++;
+				}
+			}
+			// Erase (By iterator). Erasing doesn't move any other element.
+			void					erase(iterator position)
+			{
+				this->_table.erase(position);
+			}
+			// Erase (By key)
+			size_type				erase(const key_type &k)
+			{
+				return this->_table.erase_key(k);
+			}
+			// Erase (Iterator range)
+			void					erase(iterator first, iterator last)
+			{
+				while (first != last)
+					this->_table.erase(first++);
+			}
+			// Swap
+			void					swap(flat_hash_map &x)
+			{
+				this->_table.swap(x._table);
+			}
+			// Clear. Keeps the slots.
+			void					clear()
+			{
+				this->_table.clear();
+			}
+
+			///////////////
+			// OBSERVERS //
+			///////////////
+			// Hash function
+			hasher			hash_function() const
+			{
+				return this->_table.hash_function();
+			}
+			// Key eq
+			key_equal		key_eq() const
+			{
+				return this->_table.key_eq();
+			}
+
+			////////////////
+			// OPERATIONS //
+			////////////////
+			// Find
+			iterator		find(const key_type &k)
+			{
+				return this->_table.find(k);
+			}
+			// Find (const)
+			const_iterator	find(const key_type &k) const
+			{
+				return this->_table.find(k);
+			}
+			// Find (Other key type). Only if the hash and key_equal are
+			// transparent, see hash.hpp.
+			template <class K>
+			typename ft::enable_transparent<K, Hash, Pred, iterator>::type
+							find(const K &k)
+			{
+				return this->_table.find(k);
+			}
+			// Find (Other key type, const)
+			template <class K>
+			typename ft::enable_transparent<K, Hash, Pred, const_iterator>::type
+							find(const K &k) const
+			{
+				return this->_table.find(k);
+			}
+			// Count
+			size_type		count(const key_type &k) const
+			{
+				return this->_table.count(k);
+			}
+			// Equal range
+			ft::pair<iterator, iterator>				equal_range(const key_type &k)
+			{
+				iterator	first;
+				iterator	last;
+
+				first = this->find(k);
+				last = first;
+				if (first != this->end())
+					last++;
+				return ft::pair<iterator, iterator>(first, last);
+			}
+			// Equal range (const)
+			ft::pair<const_iterator, const_iterator>	equal_range(const key_type &k) const
+			{
+				const_iterator	first;
+				const_iterator	last;
+
+				first = this->find(k);
+				last = first;
+				if (first != this->end())
+					last++;
+				return ft::pair<const_iterator, const_iterator>(first, last);
+			}
+
+			/////////////////
+			// HASH POLICY //
+			/////////////////
+			// Bucket count. Every slot is a bucket of one.
+			size_type		bucket_count() const
+			{
+				return this->_table.bucket_count();
+			}
+			// Load factor
+			float			load_factor() const
+			{
+				return this->_table.load_factor();
+			}
+			// Max load factor
+			float			max_load_factor() const
+			{
+				return this->_table.max_load_factor();
+			}
+			// Max load factor (Set). It has to be between 0.1 and 0.875.
+			void			max_load_factor(float z)
+			{
+				this->_table.max_load_factor(z);
+			}
+			// Rehash. Makes the table at least n slots big, and big enough for
+			// its elements.
+			void			rehash(size_type n)
+			{
+				this->_table.rehash(n);
+			}
+			// Reserve. Makes room for n elements without growing.
+			void			reserve(size_type n)
+			{
+				this->_table.reserve(n);
+			}
+
+			///////////////
+			// ALLOCATOR //
+			///////////////
+			allocator_type		get_allocator() const
+			{
+				return this->_table.get_allocator();
+			}
+
+		///////////////////////
+		// PRIVATE VARIABLES //
+		///////////////////////
+		private:
+			table_type		_table;
+	};
+
+	//////////////////////////
+	// RELATIONAL OPERATORS //
+	//////////////////////////
+	// == operator
+	template <class Key, class T, class Hash, class Pred, class Alloc>
+	bool		operator==(const flat_hash_map<Key, T, Hash, Pred, Alloc> &lhs,
+							const flat_hash_map<Key, T, Hash, Pred, Alloc> &rhs)
+	{
+		typename flat_hash_map<Key, T, Hash, Pred, Alloc>::const_iterator	lhsit, rhsit;
+
+		if (lhs.size() != rhs.size())
+			return false;
+		for (lhsit = lhs.begin(); lhsit != lhs.end(); lhsit++)
+		{
+			rhsit = rhs.find(lhsit->first);
+			if (rhsit == rhs.end() || !(rhsit->second == lhsit->second))
+				return false;
+		}
+		return true;
+	}
+	// != operator
+	template <class Key, class T, class Hash, class Pred, class Alloc>
+	bool		operator!=(const flat_hash_map<Key, T, Hash, Pred, Alloc> &lhs,
+							const flat_hash_map<Key, T, Hash, Pred, Alloc> &rhs)
+	{
+		return !(lhs == rhs);
+	}
+	// Swap
+	template <class Key, class T, class Hash, class Pred, class Alloc>
+	void		swap(flat_hash_map<Key, T, Hash, Pred, Alloc> &lhs,
+					flat_hash_map<Key, T, Hash, Pred, Alloc> &rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
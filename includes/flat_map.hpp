@@ -0,0 +1,611 @@
+#ifndef FLAT_MAP_HPP
+# define FLAT_MAP_HPP
+
+# include <cstddef>					// size_t, ptrdiff_t
+# include <memory>					// allocator
+# include "FlatMapIterator.hpp"		// FlatMapIterator class
+# include "ReverseIterator.hpp"		// ReverseIterator class
+# include "pair.hpp"				// pair class
+# include "utils.hpp"				// less predicate
+# include "vector.hpp"				// vector holds the keys and the values
+
+namespace ft
+{
+	// A map that keeps its keys sorted in one vector, and the values in the
+	// same order in a second vector. Lookups are a binary search over the
+	// keys, which are packed together in memory, instead of a walk down a tree
+	// with a cache miss on every level. Inserting or erasing a single element
+	// moves everything after it, so this map is meant for tables that are
+	// built in bulk and then mostly read. The range insert sorts the new
+	// elements once and merges them in, in linear time.
+	// Dereferencing an iterator gives a pair of references (see
+	// FlatMapIterator.hpp) instead of a reference to a pair.
+	template <class Key,
+			 class T,
+			 class Compare = less<Key>,
+			 class Alloc = std::allocator<ft::pair<const Key, T> > >
+	class flat_map
+	{
+		//////////////////
+		// MEMBER TYPES //
+		//////////////////
+		public:
+			typedef Key														key_type;
+			typedef T														mapped_type;
+			typedef ft::pair<const key_type, mapped_type>					value_type;
+			typedef Compare													key_compare;
+			typedef Alloc													allocator_type;
+			typedef FlatMapIterator<Key, T, T>								iterator;
+			typedef FlatMapIterator<Key, T, const T>						const_iterator;
+			typedef typename iterator::reference							reference;
+			typedef typename const_iterator::reference						const_reference;
+			typedef typename iterator::pointer								pointer;
+			typedef typename const_iterator::pointer						const_pointer;
+			typedef ReverseIterator<iterator>								reverse_iterator;
+			typedef ReverseIterator<const_iterator>							const_reverse_iterator;
+			typedef std::ptrdiff_t											difference_type;
+			typedef std::size_t												size_type;
+			typedef typename allocator_type::template rebind<Key>::other	key_allocator_type;
+			typedef typename allocator_type::template rebind<T>::other		mapped_allocator_type;
+			typedef ft::vector<Key, key_allocator_type>						key_container_type;
+			typedef ft::vector<T, mapped_allocator_type>					mapped_container_type;
+
+		////////////////
+		// VALUE_COMP //
+		////////////////
+		public:
+			class value_compare
+			{
+				protected:
+					Compare		comp;
+
+				public:
+					value_compare(Compare c) : comp(c)
+					{
+					}
+					typedef bool		result_type;
+					typedef value_type	first_argument_type;
+					typedef value_type	second_argument_type;
+
+					bool		operator() (const value_type &x, const value_type &y) const
+					{
+						return comp(x.first, y.first);
+					}
+			};
+
+		//////////////////////
+		// MEMBER FUNCTIONS //
+		//////////////////////
+		public:
+			//////////////////
+			// CONSTRUCTORS //
+			//////////////////
+			// Default constructor
+			explicit flat_map(const key_compare &comp = key_compare(),
+					const allocator_type &alloc = allocator_type())
+				: _allocator(alloc), _compare(comp), _keys(key_allocator_type(alloc)),
+					_values(mapped_allocator_type(alloc))
+			{
+			}
+			// Range constructor
+			template <class InputIterator>
+			flat_map(InputIterator first, InputIterator last,
+					const key_compare &comp = key_compare(),
+					const allocator_type &alloc = allocator_type(),
+					typename ft::iterator_traits<InputIterator>::iterator_category* = 0)
+				: _allocator(alloc), _compare(comp), _keys(key_allocator_type(alloc)),
+					_values(mapped_allocator_type(alloc))
+			{
+				this->insert(first, last);
+			}
+			// Copy constructor
+			flat_map(const flat_map &x)
+				: _allocator(x._allocator), _compare(x._compare), _keys(x._keys),
+					_values(x._values)
+			{
+			}
+			////////////////
+			// DESTRUCTOR //
+			////////////////
+			virtual ~flat_map()
+			{
+			}
+
+			/////////////////////////
+			// ASSIGNMENT OVERLOAD //
+			/////////////////////////
+			flat_map	&operator=(const flat_map &x)
+			{
+				this->_compare = x._compare;
+				this->_keys = x._keys;
+				this->_values = x._values;
+				return *this;
+			}
+
+			///////////////
+			// ITERATORS //
+			///////////////
+			// Begin
+			iterator				begin()
+			{
+				return iterator(this->_keyData(), this->_valueData());
+			}
+			// Begin (const)
+			const_iterator			begin() const
+			{
+				return const_iterator(this->_keyData(), this->_valueData());
+			}
+			// End
+			iterator				end()
+			{
+				return this->begin() + this->size();
+			}
+			// End (const)
+			const_iterator			end() const
+			{
+				return this->begin() + this->size();
+			}
+			// Reverse begin
+			reverse_iterator		rbegin()
+			{
+				return reverse_iterator(this->end());
+			}
+			// Reverse begin (const)
+			const_reverse_iterator	rbegin() const
+			{
+				return const_reverse_iterator(this->end());
+			}
+			// Reverse end
+			reverse_iterator		rend()
+			{
+				return reverse_iterator(this->begin());
+			}
+			// Reverse end (const)
+			const_reverse_iterator	rend() const
+			{
+				return const_reverse_iterator(this->begin());
+			}
+
+			//////////////
+			// CAPACITY //
+			//////////////
+			// Empty
+			bool		empty() const
+			{
+				return this->_keys.empty();
+			}
+			// Size
+			size_type	size() const
+			{
+				return this->_keys.size();
+			}
+			// Max size
+			size_type	max_size() const
+			{
+				return this->_keys.max_size();
+			}
+			// Reserve. Makes room for n elements, so building the map one
+			// element at a time doesn't reallocate.
+			void		reserve(size_type n)
+			{
+				this->_keys.reserve(n);
+				this->_values.reserve(n);
+			}
+
+			////////////////////
+			// ELEMENT ACCESS //
+			////////////////////
+			// Operator []
+			mapped_type		&operator[](const key_type &k)
+			{
+				size_type	index;
+
+				index = this->_lowerIndex(k);
+				if (index == this->size() || this->_compare(k, this->_keys[index]))
+					this->_insertAt(index, k, mapped_type());
+				return this->_values[index];
+			}
+			// Keys. All keys, in order.
+			const key_container_type	&keys() const
+			{
+				return this->_keys;
+			}
+			// Values. The values of all keys, in the same order.
+			const mapped_container_type	&values() const
+			{
+				return this->_values;
+			}
+
+			///////////////
+			// MODIFIERS //
+			///////////////
+			// Insert (Single element)
+			pair<iterator, bool>	insert(const value_type &val)
+			{
+				size_type	index;
+
+				index = this->_lowerIndex(val.first);
+				if (index != this->size() && !this->_compare(val.first, this->_keys[index]))
+					return ft::pair<iterator, bool>(this->begin() + index, false);
+				this->_insertAt(index, val.first, val.second);
+				return ft::pair<iterator, bool>(this->begin() + index, true);
+			}
+			// Insert (With hint)
+			iterator				insert(iterator position, const value_type &val)
+			{
+				size_type	index;
+
+				// The hint is good if the key goes right in front of it.
+				index = position - this->begin();
+				if ((index == this->size() || this->_compare(val.first, this->_keys[index]))
+						&& (index == 0 || this->_compare(this->_keys[index - 1], val.first)))
+				{
+					this->_insertAt(index, val.first, val.second);
+					return this->begin() + index;
+				}
+				return this->insert(val).first;
+			}
+			// Insert (Range)
+			template <class InputIterator>
+			void					insert(InputIterator first, InputIterator last,
+					typename ft::iterator_traits<InputIterator>::iterator_category* = 0)
+			{
+				ft::vector<ft::pair<Key, T> >	batch;
+
+				while (first != last)
+				{
+					batch.push_back(ft::pair<Key, T>(first->first, first->second));
+					first++;
+				}
+				if (batch.empty())
+					return ;
+				this->_sortBatch(batch);
+				this->_mergeBatch(batch);
+			}
+			// Erase (By iterator)
+			void					erase(iterator position)
+			{
+				size_type	index;
+
+				index = position - this->begin();
+				this->_keys.erase(this->_keys.begin() + index);
+				this->_values.erase(this->_values.begin() + index);
+			}
+			// Erase (By key)
+			size_type				erase(const key_type &k)
+			{
+				iterator	it;
+
+				it = this->find(k);
+				if (it == this->end())
+					return 0;
+				this->erase(it);
+				return 1;
+			}
+			// Erase (Iterator range)
+			void					erase(iterator first, iterator last)
+			{
+				size_type	from;
+				size_type	to;
+
+				from = first - this->begin();
+				to = last - this->begin();
+				this->_keys.erase(this->_keys.begin() + from, this->_keys.begin() + to);
+				this->_values.erase(this->_values.begin() + from, this->_values.begin() + to);
+			}
+			// Swap
+			void					swap(flat_map &x)
+			{
+				ft::swap(this->_compare, x._compare);
+				this->_keys.swap(x._keys);
+				this->_values.swap(x._values);
+			}
+			// Clear
+			void					clear()
+			{
+				this->_keys.clear();
+				this->_values.clear();
+			}
+
+			///////////////
+			// OBSERVERS //
+			///////////////
+			// Key comp
+			key_compare		key_comp() const
+			{
+				return this->_compare;
+			}
+			// Value comp
+			value_compare	value_comp() const
+			{
+				return value_compare(this->_compare);
+			}
+
+			////////////////
+			// OPERATIONS //
+			////////////////
+			// Find
+			iterator		find(const key_type &k)
+			{
+				return this->begin() + this->_findIndex(k);
+			}
+			// Find (const)
+			const_iterator	find(const key_type &k) const
+			{
+				return this->begin() + this->_findIndex(k);
+			}
+			// Count
+			size_type		count(const key_type &k) const
+			{
+				return (this->_findIndex(k) != this->size());
+			}
+			// Lower bound
+			iterator		lower_bound(const key_type &k)
+			{
+				return this->begin() + this->_lowerIndex(k);
+			}
+			// Lower bound (const)
+			const_iterator	lower_bound(const key_type &k) const
+			{
+				return this->begin() + this->_lowerIndex(k);
+			}
+			// Upper bound
+			iterator		upper_bound(const key_type &k)
+			{
+				return this->begin() + this->_upperIndex(k);
+			}
+			// Upper bound (const)
+			const_iterator	upper_bound(const key_type &k) const
+			{
+				return this->begin() + this->_upperIndex(k);
+			}
+			// Equal range
+			ft::pair<iterator, iterator>				equal_range(const key_type &k)
+			{
+				iterator	first;
+
+				first = this->lower_bound(k);
+				if (first != this->end() && !this->_compare(k, first->first))
+					return ft::pair<iterator, iterator>(first, first + 1);
+				return ft::pair<iterator, iterator>(first, first);
+			}
+			// Equal range (const)
+			ft::pair<const_iterator, const_iterator>	equal_range(const key_type &k) const
+			{
+				const_iterator	first;
+
+				first = this->lower_bound(k);
+				if (first != this->end() && !this->_compare(k, first->first))
+					return ft::pair<const_iterator, const_iterator>(first, first + 1);
+				return ft::pair<const_iterator, const_iterator>(first, first);
+			}
+
+			///////////////
+			// ALLOCATOR //
+			///////////////
+			allocator_type		get_allocator() const
+			{
+				return this->_allocator;
+			}
+
+		///////////////////////
+		// PRIVATE VARIABLES //
+		///////////////////////
+		private:
+			allocator_type			_allocator;
+			key_compare				_compare;
+			key_container_type		_keys;
+			mapped_container_type	_values;
+
+		//////////////////////////////
+		// PRIVATE MEMBER FUNCTIONS //
+		//////////////////////////////
+		private:
+			// These functions return the first key and value, or a null pointer
+			// if the map is empty.
+			const Key		*_keyData() const
+			{
+				if (this->_keys.empty())
+					return 0;
+				return &this->_keys[0];
+			}
+			T				*_valueData() const
+			{
+				if (this->_values.empty())
+					return 0;
+				return const_cast<T *>(&this->_values[0]);
+			}
+			// This function returns the index of the first key that is not less
+			// than k. Every step halves the range and only moves its base, which
+			// the compiler can do with a conditional move instead of a branch
+			// that the processor would mispredict half of the time.
+			size_type		_lowerIndex(const key_type &k) const
+			{
+				const Key	*keys = this->_keyData();
+				const Key	*base = keys;
+				size_type	count = this->size();
+				size_type	half;
+
+				if (count == 0)
+					return 0;
+				while (count > 1)
+				{
+					half = count / 2;
+					base = this->_compare(base[half - 1], k) ? base + half : base;
+					count -= half;
+				}
+				return (base - keys) + this->_compare(*base, k);
+			}
+			// This function returns the index of the first key that is greater
+			// than k.
+			size_type		_upperIndex(const key_type &k) const
+			{
+				size_type	index;
+
+				index = this->_lowerIndex(k);
+				if (index != this->size() && !this->_compare(k, this->_keys[index]))
+					index++;
+				return index;
+			}
+			// This function returns the index of k, or the size if k isn't in
+			// the map.
+			size_type		_findIndex(const key_type &k) const
+			{
+				size_type	index;
+
+				index = this->_lowerIndex(k);
+				if (index != this->size() && this->_compare(k, this->_keys[index]))
+					return this->size();
+				return index;
+			}
+			// This function inserts a key and its value at an index.
+			void			_insertAt(size_type index, const key_type &k, const mapped_type &val)
+			{
+				this->_keys.insert(this->_keys.begin() + index, k);
+				this->_values.insert(this->_values.begin() + index, val);
+			}
+			// This function sorts the elements of a range insert by key. It is a
+			// bottom-up merge sort, which is stable, so of a key that is in the
+			// range more than once, the first one stays in front.
+			void			_sortBatch(ft::vector<ft::pair<Key, T> > &batch)
+			{
+				ft::vector<ft::pair<Key, T> >	buffer(batch.size());
+				size_type						n = batch.size();
+				size_type						mid;
+				size_type						end;
+				size_type						left;
+				size_type						right;
+				size_type						out;
+
+				for (size_type width = 1; width < n; width *= 2)
+				{
+					for (size_type start = 0; start < n; start += 2 * width)
+					{
+						mid = (start + width < n) ? start + width : n;
+						end = (start + 2 * width < n) ? start + 2 * width : n;
+						left = start;
+						right = mid;
+						out = start;
+						while (left < mid && right < end)
+						{
+							if (this->_compare(batch[right].first, batch[left].first))
+								buffer[out++] = batch[right++];
+							else
+								buffer[out++] = batch[left++];
+						}
+						while (left < mid)
+							buffer[out++] = batch[left++];
+						while (right < end)
+							buffer[out++] = batch[right++];
+					}
+					batch.swap(buffer);
+				}
+			}
+			// This function merges the sorted elements of a range insert with
+			// the elements that are already in the map. A key that is already in
+			// the map keeps its value, and a key that is in the range more than
+			// once gets the first value, just like inserting them one by one.
+			void			_mergeBatch(const ft::vector<ft::pair<Key, T> > &batch)
+			{
+				key_container_type		keys(this->_keys.get_allocator());
+				mapped_container_type	values(this->_values.get_allocator());
+				size_type				i = 0;
+				size_type				j = 0;
+
+				keys.reserve(this->size() + batch.size());
+				values.reserve(this->size() + batch.size());
+				while (i < this->size() || j < batch.size())
+				{
+					if (j == batch.size() || (i < this->size()
+							&& !this->_compare(batch[j].first, this->_keys[i])))
+					{
+						// The key in the map goes first, also if the range has the
+						// same key.
+						keys.push_back(this->_keys[i]);
+						values.push_back(this->_values[i]);
+						i++;
+					}
+					else
+					{
+						keys.push_back(batch[j].first);
+						values.push_back(batch[j].second);
+						j++;
+					}
+					// Skip the copies in the range of the key that was just added.
+					while (j < batch.size() && !this->_compare(keys.back(), batch[j].first))
+						j++;
+				}
+				this->_keys.swap(keys);
+				this->_values.swap(values);
+			}
+	};
+
+	//////////////////////////
+	// RELATIONAL OPERATORS //
+	//////////////////////////
+	// == operator
+	template <class Key, class T, class Compare, class Alloc>
+	bool		operator==(const flat_map<Key, T, Compare, Alloc> &lhs,
+							const flat_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return (lhs.keys() == rhs.keys() && lhs.values() == rhs.values());
+	}
+	// != operator
+	template <class Key, class T, class Compare, class Alloc>
+	bool		operator!=(const flat_map<Key, T, Compare, Alloc> &lhs,
+							const flat_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return !(lhs == rhs);
+	}
+	// < operator
+	template <class Key, class T, class Compare, class Alloc>
+	bool		operator<(const flat_map<Key, T, Compare, Alloc> &lhs,
+							const flat_map<Key, T, Compare, Alloc> &rhs)
+	{
+		typename flat_map<Key, T, Compare, Alloc>::const_iterator	lhsit, rhsit;
+
+		lhsit = lhs.begin();
+		rhsit = rhs.begin();
+		while (lhsit != lhs.end())
+		{
+			if (rhsit == rhs.end() || rhsit->first < lhsit->first
+					|| (!(lhsit->first < rhsit->first) && rhsit->second < lhsit->second))
+				return false;
+			if (lhsit->first < rhsit->first || lhsit->second < rhsit->second)
+				return true;
+			lhsit++;
+			rhsit++;
+		}
+		return (rhsit != rhs.end());
+	}
+	// <= operator
+	template <class Key, class T, class Compare, class Alloc>
+	bool		operator<=(const flat_map<Key, T, Compare, Alloc> &lhs,
+							const flat_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return !(rhs < lhs);
+	}
+	// > operator
+	template <class Key, class T, class Compare, class Alloc>
+	bool		operator>(const flat_map<Key, T, Compare, Alloc> &lhs,
+							const flat_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return (rhs < lhs);
+	}
+	// >= operator
+	template <class Key, class T, class Compare, class Alloc>
+	bool		operator>=(const flat_map<Key, T, Compare, Alloc> &lhs,
+							const flat_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return !(lhs < rhs);
+	}
+	// Swap
+	template <class Key, class T, class Compare, class Alloc>
+	void		swap(flat_map<Key, T, Compare, Alloc> &lhs,
+					flat_map<Key, T, Compare, Alloc> &rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
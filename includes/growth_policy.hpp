@@ -0,0 +1,58 @@
+#ifndef GROWTH_POLICY_HPP
+# define GROWTH_POLICY_HPP
+
+# include <cstddef>				// size_t
+
+namespace ft
+{
+	// Growth policies decide how much room a vector makes when it runs out of
+	// space. They have a single static function, which gets the current
+	// capacity, the capacity that is needed at least, and the size of one
+	// element, and returns the new capacity. The result is never smaller than
+	// the required capacity. Explicit requests like reserve skip the policy.
+
+	// Doubles the capacity, which gives the fewest reallocations.
+	struct double_growth
+	{
+		static std::size_t	grow(std::size_t capacity, std::size_t required, std::size_t)
+		{
+			if (capacity * 2 > required)
+				return capacity * 2;
+			return required;
+		}
+	};
+
+	// Grows the capacity by half. The blocks that were freed earlier add up
+	// to a size that a later request fits in, so the allocator can reuse them.
+	// It also leaves less unused headroom than doubling.
+	struct half_growth
+	{
+		static std::size_t	grow(std::size_t capacity, std::size_t required, std::size_t)
+		{
+			if (capacity + capacity / 2 > required)
+				return capacity + capacity / 2;
+			return required;
+		}
+	};
+
+	// Grows the capacity by half, like half_growth. Once the buffer is at
+	// least a page, its size is rounded up to whole pages, so the memory
+	// that the system hands out is not wasted.
+	template <std::size_t PageSize = 4096>
+	struct page_growth
+	{
+		static std::size_t	grow(std::size_t capacity, std::size_t required, std::size_t elementSize)
+		{
+			std::size_t		bytes;
+
+			capacity = half_growth::grow(capacity, required, elementSize);
+			bytes = capacity * elementSize;
+			if (bytes < PageSize)
+				return capacity;
+			bytes = (bytes + PageSize - 1) / PageSize * PageSize;
+			return bytes / elementSize;
+		}
+	};
+}
+
+#endif
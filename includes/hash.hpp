@@ -0,0 +1,149 @@
+#ifndef HASH_HPP
+# define HASH_HPP
+
+# include <cstddef>				// size_t
+# include <cstring>				// strlen
+# include <string>				// string
+# include "enable_if.hpp"		// enable_if
+
+namespace ft
+{
+	// The hash function objects for the unordered containers. The hash of an
+	// integer is the integer itself, so the containers have to mix the bits
+	// before they use the low ones.
+
+	// Base struct, for types without a hash. Using it doesn't compile.
+	template <class T>
+	struct hash;
+
+	// Hash of an integral type.
+	template <class T>
+	struct integral_hash
+	{
+		std::size_t		operator() (T val) const
+		{
+			return static_cast<std::size_t>(val);
+		}
+	};
+	// Specializations for all integral types.
+	template <>
+	struct hash<bool> : public integral_hash<bool> {};
+	template <>
+	struct hash<char> : public integral_hash<char> {};
+	template <>
+	struct hash<signed char> : public integral_hash<signed char> {};
+	template <>
+	struct hash<unsigned char> : public integral_hash<unsigned char> {};
+	template <>
+	struct hash<wchar_t> : public integral_hash<wchar_t> {};
+	template <>
+	struct hash<short int> : public integral_hash<short int> {};
+	template <>
+	struct hash<unsigned short int> : public integral_hash<unsigned short int> {};
+	template <>
+	struct hash<int> : public integral_hash<int> {};
+	template <>
+	struct hash<unsigned int> : public integral_hash<unsigned int> {};
+	template <>
+	struct hash<long int> : public integral_hash<long int> {};
+	template <>
+	struct hash<unsigned long int> : public integral_hash<unsigned long int> {};
+
+	// Specialization for pointers, which hashes the address.
+	template <class T>
+	struct hash<T*>
+	{
+		std::size_t		operator() (T *ptr) const
+		{
+			return reinterpret_cast<std::size_t>(ptr);
+		}
+	};
+
+	// Hashes n bytes with FNV-1a.
+	inline std::size_t	hash_bytes(const char *bytes, std::size_t n)
+	{
+		std::size_t		result = static_cast<std::size_t>(2166136261u);
+
+		for (std::size_t i = 0; i < n; i++)
+		{
+			result ^= static_cast<unsigned char>(bytes[i]);
+			result *= static_cast<std::size_t>(16777619u);
+		}
+		return result;
+	}
+
+	// Specialization for strings.
+	template <>
+	struct hash<std::string>
+	{
+		std::size_t		operator() (const std::string &str) const
+		{
+			return ft::hash_bytes(str.data(), str.size());
+		}
+	};
+
+	// A container only looks up a key of another type than its own key type
+	// if both its hash and its key_equal say they can handle it, by having an
+	// is_transparent type.
+	template <class T>
+	struct is_transparent
+	{
+		private:
+			typedef char	true_type;
+			typedef int		false_type;
+
+			template <class U>
+				static true_type	test(typename U::is_transparent* = 0);
+			template <class U>
+				static false_type	test(...);
+
+		public:
+			static const bool		value = (sizeof(true_type) == sizeof(test<T>(0)));
+	};
+
+	// Gives Result as its type if a container with this Hash and Pred can look
+	// up a key of type K. K only makes the check depend on the key, so that
+	// an overload that doesn't apply drops out instead of failing to compile.
+	template <class K, class Hash, class Pred, class Result>
+	struct enable_transparent
+		: public ft::enable_if<is_transparent<Hash>::value && is_transparent<Pred>::value, Result>
+	{
+	};
+
+	// A hash for strings that also takes C strings, so a container of strings
+	// can look up a literal without building a string for it first.
+	struct string_hash
+	{
+		typedef void	is_transparent;
+
+		std::size_t		operator() (const std::string &str) const
+		{
+			return ft::hash_bytes(str.data(), str.size());
+		}
+		std::size_t		operator() (const char *str) const
+		{
+			return ft::hash_bytes(str, std::strlen(str));
+		}
+	};
+
+	// The key_equal that goes with string_hash.
+	struct string_equal
+	{
+		typedef void	is_transparent;
+
+		bool	operator() (const std::string &x, const std::string &y) const
+		{
+			return (x == y);
+		}
+		bool	operator() (const std::string &x, const char *y) const
+		{
+			return (x == y);
+		}
+		bool	operator() (const char *x, const std::string &y) const
+		{
+			return (y == x);
+		}
+	};
+}
+
+#endif
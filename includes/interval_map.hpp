@@ -0,0 +1,258 @@
+#ifndef INTERVAL_MAP_HPP
+# define INTERVAL_MAP_HPP
+
+# include <memory>				// allocator
+# include "map.hpp"				// map class
+# include "pair.hpp"			// pair class
+# include "utils.hpp"			// less predicate
+
+namespace ft
+{
+	// Orders intervals by their start, and intervals with the same start by
+	// their end, so an interval map can hold several intervals that start at
+	// the same point.
+	template <class Point, class Compare>
+	class interval_compare
+	{
+		public:
+			// Parameterized constructor
+			interval_compare(const Compare &comp = Compare()) : _comp(comp)
+			{
+			}
+			// () operator
+			bool		operator() (const ft::pair<Point, Point> &x, const ft::pair<Point, Point> &y) const
+			{
+				if (this->_comp(x.first, y.first))
+					return true;
+				if (this->_comp(y.first, x.first))
+					return false;
+				return this->_comp(x.second, y.second);
+			}
+			// Point comp. The compare for single points.
+			Compare		point_comp() const
+			{
+				return this->_comp;
+			}
+
+		private:
+			Compare		_comp;
+	};
+
+	// The augment policy of an interval map (see augment_policy.hpp). Every
+	// node knows the highest end of all intervals in its subtree, so a search
+	// can skip a subtree that ends before the interval it looks for. The
+	// highest end is found with the point compare of the map, so it follows
+	// the same order as the intervals.
+	template <class Point, class Compare>
+	struct interval_max_end
+	{
+		static const bool	enabled = true;
+
+		struct node_data
+		{
+			Point		maxEnd;
+		};
+
+		template <class Node>
+		static void		update(Node &node, const interval_compare<Point, Compare> &intervalComp)
+		{
+			Compare		comp = intervalComp.point_comp();
+
+			node.maxEnd = node.data.first.second;
+			if (node.left && comp(node.maxEnd, node.left->maxEnd))
+				node.maxEnd = node.left->maxEnd;
+			if (node.right && comp(node.maxEnd, node.right->maxEnd))
+				node.maxEnd = node.right->maxEnd;
+		}
+	};
+
+	// A map from closed intervals [start, end] to values, with the interval
+	// as a pair of points. The start of an interval may not come after its
+	// end. It is an AVL tree like ft::map, and is ordered by start, so it
+	// iterates the same way. On top of that, it finds the intervals that
+	// overlap a range, or that contain a point, by walking only the subtrees
+	// that can have such intervals.
+	template <class Point,
+			 class T,
+			 class Compare = ft::less<Point>,
+			 class Alloc = std::allocator<ft::pair<const ft::pair<Point, Point>, T> > >
+	class interval_map
+		: public map<ft::pair<Point, Point>, T, interval_compare<Point, Compare>, Alloc,
+			interval_max_end<Point, Compare> >
+	{
+		//////////////////
+		// MEMBER TYPES //
+		//////////////////
+		public:
+			typedef map<ft::pair<Point, Point>, T, interval_compare<Point, Compare>, Alloc,
+					interval_max_end<Point, Compare> >						base_map;
+			typedef Point													point_type;
+			typedef Compare													point_compare;
+			typedef typename base_map::key_type								interval_type;
+			typedef typename base_map::value_type							value_type;
+			typedef typename base_map::key_compare							key_compare;
+			typedef typename base_map::allocator_type						allocator_type;
+			typedef typename base_map::iterator								iterator;
+			typedef typename base_map::const_iterator						const_iterator;
+			typedef typename base_map::size_type							size_type;
+
+		//////////////////////
+		// MEMBER FUNCTIONS //
+		//////////////////////
+		public:
+			//////////////////
+			// CONSTRUCTORS //
+			//////////////////
+			// Default constructor
+			explicit interval_map(const point_compare &comp = point_compare(),
+					const allocator_type &alloc = allocator_type())
+				: base_map(key_compare(comp), alloc)
+			{
+			}
+			// Range constructor
+			template <class InputIterator>
+			interval_map(InputIterator first, InputIterator last,
+					const point_compare &comp = point_compare(),
+					const allocator_type &alloc = allocator_type(),
+					typename ft::iterator_traits<InputIterator>::iterator_category* = 0)
+				: base_map(first, last, key_compare(comp), alloc)
+			{
+			}
+			// Copy constructor
+			interval_map(const interval_map &x) : base_map(x)
+			{
+			}
+			////////////////
+			// DESTRUCTOR //
+			////////////////
+			virtual ~interval_map()
+			{
+			}
+
+			/////////////////////////
+			// ASSIGNMENT OVERLOAD //
+			/////////////////////////
+			interval_map	&operator=(const interval_map &x)
+			{
+				base_map::operator=(x);
+				return *this;
+			}
+
+			///////////////
+			// MODIFIERS //
+			///////////////
+			using base_map::insert;
+			// Insert (Interval). Adds [start, end] with val, unless that exact
+			// interval is in the map already.
+			ft::pair<iterator, bool>	insert(const point_type &start, const point_type &end,
+					const T &val)
+			{
+				return this->insert(value_type(interval_type(start, end), val));
+			}
+
+			/////////////
+			// QUERIES //
+			/////////////
+			// Overlaps. Writes an iterator to every interval that has a point in
+			// common with [a, b] to out, in order, and returns out after them.
+			template <class OutputIterator>
+			OutputIterator	overlaps(const point_type &a, const point_type &b, OutputIterator out)
+			{
+				this->template _collect<iterator>(this->_root, a, b, out);
+				return out;
+			}
+			// Overlaps (const)
+			template <class OutputIterator>
+			OutputIterator	overlaps(const point_type &a, const point_type &b, OutputIterator out) const
+			{
+				this->template _collect<const_iterator>(this->_root, a, b, out);
+				return out;
+			}
+			// Stab. Writes an iterator to every interval that contains p to out.
+			template <class OutputIterator>
+			OutputIterator	stab(const point_type &p, OutputIterator out)
+			{
+				return this->overlaps(p, p, out);
+			}
+			// Stab (const)
+			template <class OutputIterator>
+			OutputIterator	stab(const point_type &p, OutputIterator out) const
+			{
+				return this->overlaps(p, p, out);
+			}
+			// First overlap. The first interval that has a point in common with
+			// [a, b], or end() if there is none.
+			iterator		first_overlap(const point_type &a, const point_type &b)
+			{
+				return iterator(this->_firstOverlap(a, b));
+			}
+			// First overlap (const)
+			const_iterator	first_overlap(const point_type &a, const point_type &b) const
+			{
+				return const_iterator(this->_firstOverlap(a, b));
+			}
+
+			///////////////
+			// OBSERVERS //
+			///////////////
+			// Point comp
+			point_compare	point_comp() const
+			{
+				return this->_compare.point_comp();
+			}
+
+		//////////////////////////////
+		// PRIVATE MEMBER FUNCTIONS //
+		//////////////////////////////
+		private:
+			typedef typename base_map::Node		Node;
+
+			// This function writes the intervals below node that overlap [a, b]
+			// to out, in order. A subtree whose highest end is before a has none,
+			// and once an interval starts after b, so does everything after it.
+			template <class Iterator, class OutputIterator>
+			void			_collect(Node *node, const point_type &a, const point_type &b,
+					OutputIterator &out) const
+			{
+				point_compare	comp = this->point_comp();
+
+				while (node && !comp(node->maxEnd, a))
+				{
+					this->template _collect<Iterator>(node->left, a, b, out);
+					if (comp(b, node->data.first.first))
+						return ;
+					if (!comp(node->data.first.second, a))
+					{
+						*out = Iterator(node);
+						++out;
+					}
+					node = node->right;
+				}
+			}
+			// This function finds the first interval that overlaps [a, b], or
+			// the end sentinel. If the left subtree has an interval that ends at
+			// or after a, the answer can only be in there: the intervals in it
+			// that end early enough start too late, and so does the rest.
+			Node			*_firstOverlap(const point_type &a, const point_type &b) const
+			{
+				point_compare	comp = this->point_comp();
+				Node			*node;
+
+				node = this->_root;
+				while (node && !comp(node->maxEnd, a))
+				{
+					if (node->left && !comp(node->left->maxEnd, a))
+						node = node->left;
+					else if (comp(b, node->data.first.first))
+						break ;
+					else if (!comp(node->data.first.second, a))
+						return node;
+					else
+						node = node->right;
+				}
+				return const_cast<Node *>(&this->_header);
+			}
+	};
+}
+
+#endif
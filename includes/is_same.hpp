@@ -0,0 +1,22 @@
+#ifndef IS_SAME_HPP
+# define IS_SAME_HPP
+
+namespace ft
+{
+	// Base struct, for two different types. It returns false.
+	template <class T, class U>
+	struct is_same
+	{
+		typedef bool		value_type;
+		static const bool	value = false;
+	};
+	// Specialization for two of the same type, this returns true.
+	template <class T>
+	struct is_same<T, T>
+	{
+		typedef bool		value_type;
+		static const bool	value = true;
+	};
+}
+
+#endif
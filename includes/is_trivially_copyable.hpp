@@ -0,0 +1,17 @@
+#ifndef IS_TRIVIALLY_COPYABLE_HPP
+# define IS_TRIVIALLY_COPYABLE_HPP
+
+namespace ft
+{
+	// Tells if objects of a type can be copied around as raw bytes. C++98 has
+	// no way to find this out, so we ask the compiler. Both gcc and clang
+	// support this builtin in every language mode.
+	template <class T>
+	struct is_trivially_copyable
+	{
+		typedef bool		value_type;
+		static const bool	value = __is_trivially_copyable(T);
+	};
+}
+
+#endif
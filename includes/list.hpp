@@ -53,8 +53,8 @@ namespace ft
 					}
 					// Copy constructor
 					Node(Node const &src)
+						: data(src.data), next(src.next), prev(src.prev)
 					{
-						*this = src;
 					}
 					// Destructor
 					virtual ~Node()
@@ -66,6 +66,7 @@ namespace ft
 						this->data = src.data;
 						this->next = src.next;
 						this->prev = src.prev;
+						return *this;
 					}
 					// Function to return the next pointer
 					Node	*nextNode() const
@@ -111,7 +112,7 @@ namespace ft
 			template <class InputIterator>
 			list(InputIterator first, InputIterator last,
 					const allocator_type &alloc = allocator_type(),
-					typename ft::iterator_traits<InputIterator>::type* = 0)
+					typename ft::iterator_traits<InputIterator>::iterator_category* = 0)
 			{
 				this->_setUpSentinelNode();
 				this->_allocator = alloc;
@@ -242,7 +243,7 @@ namespace ft
 			// Assign (range)
 			template <class InputIterator>
 			void		assign(InputIterator first, InputIterator last,
-					typename ft::iterator_traits<InputIterator>::type* = 0)
+					typename ft::iterator_traits<InputIterator>::iterator_category* = 0)
 			{
 				size_t		prevSize = this->_size;
 				size_t		amount = ft::distance(first, last);
@@ -307,7 +308,7 @@ namespace ft
 			// Insert (range)
 			template <class InputIterator>
 			void		insert(iterator position, InputIterator first, InputIterator last,
-					typename ft::iterator_traits<InputIterator>::type* = 0)
+					typename ft::iterator_traits<InputIterator>::iterator_category* = 0)
 			{
 				Node	*location;
 
@@ -348,11 +349,13 @@ namespace ft
 			// Swap
 			void		swap(list &x)
 			{
-				list<T>		tmp;
-
-				tmp.splice(tmp.begin(), *this);
-				this->splice(this->begin(), x);
-				x.splice(x.begin(), tmp);
+				ft::swap(this->_sentinel.next, x._sentinel.next);
+				ft::swap(this->_sentinel.prev, x._sentinel.prev);
+				ft::swap(this->_size, x._size);
+				// The nodes have to go back to the allocator they came from.
+				ft::swap(this->_allocator, x._allocator);
+				this->_relinkSentinelNode();
+				x._relinkSentinelNode();
 			}
 			// Resize
 			void		resize(size_type n, value_type val = value_type())
@@ -400,13 +403,26 @@ namespace ft
 			// Splice (Element range)
 			void		splice(iterator position, list &x, iterator first, iterator last)
 			{
-				iterator	tmp;
-				while (first != last)
-				{
-					tmp = first;
-					first++;
-					splice(position, x, tmp);
-				}
+				Node		*location;
+				Node		*firstNode;
+				Node		*lastNode;
+				size_type	amount;
+
+				if (first == last)
+					return ;
+				location = this->_findNode(position);
+				firstNode = this->_findNode(first);
+				lastNode = this->_findNode(last)->prev;
+				// Moving nodes within the same list doesn't change its size.
+				amount = (this == &x) ? 0 : ft::distance(first, last);
+				firstNode->prev->next = lastNode->next;
+				lastNode->next->prev = firstNode->prev;
+				x._size -= amount;
+				firstNode->prev = location->prev;
+				lastNode->next = location;
+				location->prev->next = firstNode;
+				location->prev = lastNode;
+				this->_size += amount;
 			}
 			// Remove
 			void		remove(const value_type &val)
@@ -470,28 +486,46 @@ namespace ft
 				this->merge(x, ft::less<T>());
 			}
 			// Merge (Comparison function)
+			// The nodes of x are linked in between the nodes of this list in a single
+			// pass over both lists. Once the end of this list is reached, the rest of
+			// x is linked in at once. The sizes are only updated at the end.
 			template <class Compare>
 			void		merge(list &x, Compare comp)
 			{
 				Node	*curr;
 				Node	*node;
+				Node	*next;
 
-				if (this == &x)
+				if (this == &x || x._size == 0)
 					return ;
 				curr = this->_sentinel.next;
-				while (curr != &this->_sentinel && x.size() != 0)
+				node = x._sentinel.next;
+				while (node != &x._sentinel)
 				{
-					node = x._sentinel.next;
-					if (comp(node->data, curr->data))
+					if (curr == &this->_sentinel)
+					{
+						node->prev = curr->prev;
+						curr->prev->next = node;
+						curr->prev = x._sentinel.prev;
+						x._sentinel.prev->next = curr;
+						break ;
+					}
+					if (!comp(node->data, curr->data))
 					{
-						x._removeFromList(node);
-						this->_insertNodeInList(node, curr->prev);
+						curr = curr->next;
 						continue ;
 					}
-					curr = curr->next;
+					next = node->next;
+					node->prev = curr->prev;
+					node->next = curr;
+					curr->prev->next = node;
+					curr->prev = node;
+					node = next;
 				}
-				if (x.size() != 0)
-					this->splice(this->end(), x);
+				this->_size += x._size;
+				x._size = 0;
+				x._sentinel.next = &x._sentinel;
+				x._sentinel.prev = &x._sentinel;
 			}
 			// Sort (No parameters)
 			void		sort()
@@ -499,32 +533,61 @@ namespace ft
 				this->sort(ft::less<T>());
 			}
 			// Sort (Comparison function)
+			// This is a bottom-up merge sort. Every node is taken off the list as a
+			// run of one, and merged with the runs in the buckets: bucket i holds a
+			// sorted run of 2^i nodes, or nothing. The runs are only linked through
+			// their next pointers while sorting, the prev pointers are fixed at the
+			// end. Earlier nodes always end up on the left side of a merge, so equal
+			// elements keep their order.
 			template <class Compare>
 			void		sort(Compare comp)
 			{
-				list<T>		tmp;
-				size_t		pos;
-				iterator	it;
+				// 64 buckets are enough for any list that fits in memory.
+				Node		*buckets[64];
+				Node		*run;
+				Node		*curr;
+				Node		*next;
+				size_type	i;
 
 				if (this->_size < 2)
 					return ;
-				pos = this->_size / 2;
-				it = this->begin();
-				for (size_t i = 0; i < pos; i++)
-					it++;
-				tmp.splice(tmp.begin(), *this, it, this->end());
-				tmp.sort(comp);
-				this->sort(comp);
-				this->merge(tmp, comp);
+				for (i = 0; i < 64; i++)
+					buckets[i] = 0;
+				curr = this->_sentinel.next;
+				while (curr != &this->_sentinel)
+				{
+					next = curr->next;
+					curr->next = 0;
+					run = curr;
+					for (i = 0; buckets[i]; i++)
+					{
+						run = this->_mergeRuns(buckets[i], run, comp);
+						buckets[i] = 0;
+					}
+					buckets[i] = run;
+					curr = next;
+				}
+				run = 0;
+				for (i = 0; i < 64; i++)
+				{
+					if (buckets[i])
+						run = run ? this->_mergeRuns(buckets[i], run, comp) : buckets[i];
+				}
+				this->_relinkRun(run);
 			}
 			// Reverse
+			// Swapping the next and prev pointers of every node, the sentinel
+			// included, turns the list around.
 			void		reverse()
 			{
-				list<T>				tmp;
+				Node	*curr;
 
-				while (this->_size > 0)
-					tmp.splice(tmp.end(), *this, --(this->end()));
-				this->splice(this->begin(), tmp);
+				curr = &this->_sentinel;
+				do
+				{
+					ft::swap(curr->next, curr->prev);
+					curr = curr->prev;
+				} while (curr != &this->_sentinel);
 			}
 			///////////////
 			// OBSERVERS //
@@ -554,6 +617,19 @@ namespace ft
 				this->_sentinel.prev = &this->_sentinel;
 				this->_sentinel.data = T();
 			}
+			// This function makes the first and last node point back to the sentinel,
+			// after the sentinel links were swapped with another list.
+			void		_relinkSentinelNode()
+			{
+				if (this->_size == 0)
+				{
+					this->_sentinel.next = &this->_sentinel;
+					this->_sentinel.prev = &this->_sentinel;
+					return ;
+				}
+				this->_sentinel.next->prev = &this->_sentinel;
+				this->_sentinel.prev->next = &this->_sentinel;
+			}
 			// This function creates a new node and inserts it in between two existing
 			// nodes in the list.
 			void		_makeNode(const value_type &val, Node *prev)
@@ -608,16 +684,50 @@ namespace ft
 			// This function will return the node that an iterator is pointing to.
 			Node	*_findNode(iterator position)
 			{
-				iterator	start;
-				Node	*location;
-				size_t		pos;
+				return position.node();
+			}
+			// This function merges two sorted runs of nodes, which are linked through
+			// their next pointers and end in a null pointer. On equal elements the
+			// node from the left run goes first.
+			template <class Compare>
+			Node	*_mergeRuns(Node *left, Node *right, Compare comp)
+			{
+				Node	*head;
+				Node	**tail;
 
-				location = this->_sentinel.next;
-				start = this->begin();
-				pos = ft::distance(start, position);
-				for (size_t i = 0; i < pos; i++)
-					location = location->next;
-				return location;
+				tail = &head;
+				while (left && right)
+				{
+					if (comp(right->data, left->data))
+					{
+						*tail = right;
+						right = right->next;
+					}
+					else
+					{
+						*tail = left;
+						left = left->next;
+					}
+					tail = &(*tail)->next;
+				}
+				*tail = left ? left : right;
+				return head;
+			}
+			// This function makes a run of nodes, linked only through their next
+			// pointers, the contents of the list again. The size doesn't change.
+			void		_relinkRun(Node *run)
+			{
+				Node	*prev;
+
+				prev = &this->_sentinel;
+				for (; run; run = run->next)
+				{
+					run->prev = prev;
+					prev->next = run;
+					prev = run;
+				}
+				prev->next = &this->_sentinel;
+				this->_sentinel.prev = prev;
 			}
 			// This function destroys all elements, and relinks the sentinel
 			// to itself, in case it needs to be reused.
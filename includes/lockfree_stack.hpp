@@ -0,0 +1,232 @@
+#ifndef LOCKFREE_STACK_HPP
+# define LOCKFREE_STACK_HPP
+
+# include <cstddef>				// size_t
+# include <memory>				// allocator
+# include <stdint.h>			// uint32_t, uint64_t
+# include "atomic.hpp"			// atomic operations
+
+namespace ft
+{
+	// A stack that any number of threads can push to and pop from without
+	// taking a lock (a Treiber stack). The top of the stack is a single 64 bit
+	// word that holds the index of the top node and a tag, and every push and
+	// pop swaps in a new word with the tag one higher. A thread that read the
+	// top, got delayed, and finds the same node on top again later still fails
+	// its compare and swap, because the tag has moved on (the ABA problem).
+	// Nodes are never given back to the allocator while the stack lives. A
+	// popped node goes onto a free list, which is a tagged stack as well, and
+	// the next push takes it from there. So a thread that is still looking at
+	// a node that was popped by another thread never reads freed memory.
+	// Nodes are allocated in chunks that double in size, and found by index.
+	template <class T>
+	class lockfree_stack
+	{
+		//////////////////
+		// MEMBER TYPES //
+		//////////////////
+		public:
+			typedef T					value_type;
+			typedef std::size_t			size_type;
+			typedef T&					reference;
+			typedef const T&			const_reference;
+
+		private:
+			struct Node
+			{
+				T				value;
+				// The index of the node below this one, plus one. Zero is the
+				// bottom of the stack.
+				uint32_t		next;
+			};
+
+			typedef std::allocator<Node>	NodeAlloc;
+
+		//////////////////////
+		// MEMBER FUNCTIONS //
+		//////////////////////
+		public:
+			//////////////////
+			// CONSTRUCTORS //
+			//////////////////
+			// Default constructor
+			lockfree_stack() : _top(0), _free(0), _nodeCount(0)
+			{
+				for (size_type i = 0; i < _maxChunks; i++)
+					this->_chunks[i] = 0;
+			}
+			////////////////
+			// DESTRUCTOR //
+			////////////////
+			~lockfree_stack()
+			{
+				uint32_t	index = static_cast<uint32_t>(this->_top);
+
+				while (index != 0)
+				{
+					this->_allocator.destroy(&this->_node(index)->value);
+					index = this->_node(index)->next;
+				}
+				for (size_type i = 0; i < _maxChunks; i++)
+					if (this->_chunks[i] != 0)
+						this->_nodeAllocator.deallocate(this->_chunks[i], _firstChunk << i);
+			}
+
+			//////////////
+			// CAPACITY //
+			//////////////
+			// Empty. Only exact when no other thread uses the stack.
+			bool		empty() const
+			{
+				return (static_cast<uint32_t>(ft::atomic_load(&this->_top, ft::memory_order_acquire)) == 0);
+			}
+
+			////////////////////
+			// ELEMENT ACCESS //
+			////////////////////
+			// Top. The stack must not be empty, and no other thread may pop
+			// while the reference is in use.
+			reference			top()
+			{
+				return this->_node(static_cast<uint32_t>(
+					ft::atomic_load(&this->_top, ft::memory_order_acquire)))->value;
+			}
+			// Top (const)
+			const_reference		top() const
+			{
+				return this->_node(static_cast<uint32_t>(
+					ft::atomic_load(&this->_top, ft::memory_order_acquire)))->value;
+			}
+
+			///////////////
+			// MODIFIERS //
+			///////////////
+			// Push
+			void		push(const value_type &val)
+			{
+				uint32_t	index = this->_popIndex(this->_free);
+
+				if (index == 0)
+					index = this->_newIndex();
+				this->_allocator.construct(&this->_node(index)->value, val);
+				this->_pushIndex(this->_top, index);
+			}
+			// Try pop. Moves the top element into val. Returns false if the stack
+			// is empty.
+			bool		try_pop(value_type &val)
+			{
+				uint32_t	index = this->_popIndex(this->_top);
+
+				if (index == 0)
+					return false;
+				val = this->_node(index)->value;
+				this->_allocator.destroy(&this->_node(index)->value);
+				this->_pushIndex(this->_free, index);
+				return true;
+			}
+			// Pop. Removes the top element, the stack must not be empty.
+			void		pop()
+			{
+				uint32_t	index = this->_popIndex(this->_top);
+
+				this->_allocator.destroy(&this->_node(index)->value);
+				this->_pushIndex(this->_free, index);
+			}
+
+		///////////////////////
+		// PRIVATE VARIABLES //
+		///////////////////////
+		private:
+			// Chunk i holds _firstChunk << i nodes, so 27 chunks hold every
+			// index a uint32_t can have.
+			static const size_type		_firstChunk = 64;
+			static const size_type		_maxChunks = 27;
+
+			// The tag in the high half, the index of the top node plus one in
+			// the low half.
+			uint64_t				_top;
+			uint64_t				_free;
+			// The amount of nodes that were ever handed out.
+			uint32_t				_nodeCount;
+			Node					*_chunks[_maxChunks];
+			std::allocator<T>		_allocator;
+			NodeAlloc				_nodeAllocator;
+
+			// A stack can't be copied while other threads are using it.
+			lockfree_stack(const lockfree_stack &);
+			lockfree_stack	&operator=(const lockfree_stack &);
+
+		//////////////////////////////
+		// PRIVATE MEMBER FUNCTIONS //
+		//////////////////////////////
+		private:
+			// This function returns the node for an index (plus one). The chunk
+			// of index i + 1 is the position of the highest bit of i + 64, minus 6.
+			Node		*_node(uint32_t index) const
+			{
+				uint64_t	position = static_cast<uint64_t>(index) - 1 + _firstChunk;
+				size_type	chunk = 63 - __builtin_clzll(position) - 6;
+
+				return ft::atomic_load(&this->_chunks[chunk], ft::memory_order_acquire)
+					+ (position - (_firstChunk << chunk));
+			}
+			// This function hands out a node that was never used before. The
+			// first thread that needs a chunk allocates it, and if two threads
+			// race for it, the loser gives its chunk back.
+			uint32_t	_newIndex()
+			{
+				uint32_t	index = ft::atomic_fetch_add(&this->_nodeCount, 1u, ft::memory_order_relaxed) + 1;
+				uint64_t	position = static_cast<uint64_t>(index) - 1 + _firstChunk;
+				size_type	chunk = 63 - __builtin_clzll(position) - 6;
+				Node		*expected = 0;
+				Node		*fresh;
+
+				if (ft::atomic_load(&this->_chunks[chunk], ft::memory_order_acquire) != 0)
+					return index;
+				fresh = this->_nodeAllocator.allocate(_firstChunk << chunk);
+				if (!ft::atomic_compare_exchange(&this->_chunks[chunk], expected, fresh,
+						ft::memory_order_acq_rel, ft::memory_order_acquire))
+					this->_nodeAllocator.deallocate(fresh, _firstChunk << chunk);
+				return index;
+			}
+			// This function puts a node on top of a tagged stack.
+			void		_pushIndex(uint64_t &top, uint32_t index)
+			{
+				Node		*node = this->_node(index);
+				uint64_t	old = ft::atomic_load(&top, ft::memory_order_relaxed);
+
+				do
+				{
+					ft::atomic_store(&node->next, static_cast<uint32_t>(old), ft::memory_order_relaxed);
+				}
+				while (!ft::atomic_compare_exchange(&top, old, this->_nextTag(old) | index,
+						ft::memory_order_release, ft::memory_order_relaxed));
+			}
+			// This function takes the top node off a tagged stack, and returns
+			// its index, or zero if the stack is empty.
+			uint32_t	_popIndex(uint64_t &top)
+			{
+				uint64_t	old = ft::atomic_load(&top, ft::memory_order_acquire);
+				uint32_t	index;
+				uint32_t	next;
+
+				do
+				{
+					index = static_cast<uint32_t>(old);
+					if (index == 0)
+						return 0;
+					next = ft::atomic_load(&this->_node(index)->next, ft::memory_order_relaxed);
+				}
+				while (!ft::atomic_compare_exchange(&top, old, this->_nextTag(old) | next,
+						ft::memory_order_acquire, ft::memory_order_acquire));
+				return index;
+			}
+			// This function returns the tag half of a top word, one higher.
+			uint64_t	_nextTag(uint64_t word) const
+			{
+				return ((word >> 32) + 1) << 32;
+			}
+	};
+}
+
+#endif
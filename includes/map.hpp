@@ -2,10 +2,14 @@
 # define MAP_HPP
 
 # include <cstddef>					// size_t, ptrdiff_t
+# include <iterator>				// input_iterator_tag, forward_iterator_tag
 # include <memory>					// allocator
 # include "NodeIterator.hpp"		// NodeIterator class
+# include "augment_policy.hpp"		// no_augment, order_statistics
 # include "ReverseIterator.hpp"		// ReverseIterator class
+# include "is_trivially_copyable.hpp"	// is_trivially_copyable
 # include "pair.hpp"				// pair class
+# include "pool_allocator.hpp"		// pool_allocator, for releasing all nodes at once
 # include "utils.hpp"				// less predicate, lexicographical_compare
 
 namespace ft
@@ -13,7 +17,8 @@ namespace ft
 	template <class Key,
 			 class T,
 			 class Compare = less<Key>,
-			 class Alloc = std::allocator<ft::pair<const Key, T> > >
+			 class Alloc = std::allocator<ft::pair<const Key, T> >,
+			 class Augment = ft::no_augment >
 	class map
 	{
 		// Forward declaration of Node
@@ -29,6 +34,7 @@ namespace ft
 			typedef ft::pair<const key_type, mapped_type>					value_type;
 			typedef Compare													key_compare;
 			typedef Alloc													allocator_type;
+			typedef Augment													augment_policy;
 			typedef typename allocator_type::reference						reference;
 			typedef typename allocator_type::const_reference				const_reference;
 			typedef typename allocator_type::pointer						pointer;
@@ -67,37 +73,43 @@ namespace ft
 		//////////
 		// NODE //
 		//////////
+		// The nodes don't know which map they belong to. Instead, every map has
+		// one sentinel node that acts as end(), and the root of the tree hangs
+		// on its left side. That way the in-order walk reaches the sentinel
+		// right after the highest node, without any per-node bookkeeping.
+		// A node also carries the data of the augment policy, which is empty
+		// by default.
 		private:
-			class Node
+			class Node : public Augment::node_data
 			{
 				public:
 					// Default constructor
-					Node() : data(value_type()), height(0), left(0), right(0), parent(0), leftMost(0), rightMost(0)
+					Node() : left(0), right(0), parent(0), data(value_type()), height(0)
 					{
 					}
 					// Parameterized constructor
 					Node(value_type const &val)
-						: data(val), height(1), left(0), right(0), parent(0), leftMost(0), rightMost(0)
+						: left(0), right(0), parent(0), data(val), height(1)
 					{
 					}
 					// Copy constructor
 					Node(Node const &src)
+						: Augment::node_data(src), left(src.left), right(src.right), parent(src.parent),
+							data(src.data), height(src.height)
 					{
-						*this = src;
 					}
 					// Destructor
-					virtual ~Node()
+					~Node()
 					{
 					}
 					// Assignment operator overload
 					Node		&operator=(Node const &src)
 					{
-						this->height = src.height;
+						Augment::node_data::operator=(src);
 						this->left = src.left;
 						this->right = src.right;
 						this->parent = src.parent;
-						this->leftMost = src.leftMost;
-						this->rightMost = src.rightMost;
+						this->height = src.height;
 						return *this;
 					}
 					// Function to return the next node.
@@ -105,76 +117,42 @@ namespace ft
 					{
 						Node		*returnNode;
 
-						// If we are the rightMost, return 0
-						if (this == this->rightMost)
-							return 0;
-						// If we are the leftMost, find the lowest value in the map.
-						// If we have a right subtree, find its lowest value in the subtree.
-						if (this == this->leftMost || this->right)
+						// If we have a right subtree, find its lowest value.
+						if (this->right)
 						{
-							if (this == this->leftMost)
-							{
-								// leftMost and rightMost use their 'right' pointer to
-								// represent the root of the tree.
-								returnNode = this->right;
-								if (returnNode == 0)
-									return this->rightMost;
-							}
-							else
-								returnNode = this->right;
+							returnNode = this->right;
 							while (returnNode->left)
 								returnNode = returnNode->left;
 							return returnNode;
 						}
 						// If we do not have a right child, traverse up the tree until
-						// we've gone up from a left leaf. If at any point we encounter
-						// a parent of 0, return rightMost.
+						// we've gone up from a left child. For the highest node, this
+						// ends at the sentinel, since the root is its left child.
 						returnNode = const_cast<Node *>(this);
-						while (returnNode->parent)
-						{
-							if (returnNode->isOnLeft())
-								return returnNode->parent;
+						while (returnNode->parent && !returnNode->isOnLeft())
 							returnNode = returnNode->parent;
-						}
-						return this->rightMost;
+						return returnNode->parent;
 					}
 					// Function to return the previous node.
 					Node		*prevNode() const
 					{
 						Node		*returnNode;
 
-						// If we are the leftMost, return 0
-						if (this == this->leftMost)
-							return 0;
-						// If we are the rightMost, find the highest value in the map.
-						// If we have a right subtree, find its highest value in the subtree.
-						if (this == this->rightMost || this->left)
+						// If we have a left subtree, find its highest value. For the
+						// sentinel, that is the highest value in the map.
+						if (this->left)
 						{
-							if (this == this->rightMost)
-							{
-								// leftMost and rightMost use their 'right' pointer to
-								// represent the root of the tree.
-								returnNode = this->right;
-								if (returnNode == 0)
-									return this->leftMost;
-							}
-							else
-								returnNode = this->left;
+							returnNode = this->left;
 							while (returnNode->right)
 								returnNode = returnNode->right;
 							return returnNode;
 						}
 						// If we do not have a left child, traverse up the tree until
-						// we've gone up from a right leaf. If at any point we encounter
-						// a parent of 0, return leftMost.
+						// we've gone up from a right child.
 						returnNode = const_cast<Node *>(this);
-						while (returnNode->parent)
-						{
-							if (!returnNode->isOnLeft())
-								return returnNode->parent;
+						while (returnNode->parent && returnNode->isOnLeft())
 							returnNode = returnNode->parent;
-						}
-						return returnNode;
+						return returnNode->parent;
 					}
 
 					// Public helper functions
@@ -196,31 +174,28 @@ namespace ft
 						highest = (left < right) ? right : left;
 						this->height = 1 + highest;
 					}
+					// Update the height and the augment data of this node, after its
+					// children are up to date. The augment data may depend on the
+					// order of the keys, so it gets the compare of the map.
+					void		update(const key_compare &comp)
+					{
+						this->updateHeight();
+						Augment::update(*this, comp);
+					}
 					// Get the balance of this node.
 					int			getBalance()
 					{
 						return (this->_getLeftHeight() - this->_getRightHeight());
 					}
-					// This function will set the leftMost and rightMost pointers
-					// for itself, and any children it has.
-					void		updateSentinelLinks(Node *newLeft, Node *newRight)
-					{
-						this->leftMost = newLeft;
-						this->rightMost = newRight;
-						if (this->left)
-							this->left->updateSentinelLinks(newLeft, newRight);
-						if (this->right)
-							this->right->updateSentinelLinks(newLeft, newRight);
-					}
 
 					// Public variables
-					value_type		data;
-					int				height;
+					// The height comes last, so it fills the padding after the data
+					// instead of needing padding of its own.
 					Node			*left;
 					Node			*right;
 					Node			*parent;
-					Node			*leftMost;
-					Node			*rightMost;
+					value_type		data;
+					int				height;
 
 				private:
 					// Private helper functions
@@ -250,7 +225,7 @@ namespace ft
 			explicit map(const key_compare &comp = key_compare(),
 					const allocator_type &alloc = allocator_type())
 				: _allocator(alloc), _compare(comp),
-					_valueCompare(value_compare(comp)), _root(0), _size(0)
+					_valueCompare(value_compare(comp)), _root(0), _minNode(0), _maxNode(0), _size(0)
 			{
 				this->_initSentinelNodes();
 			}
@@ -259,9 +234,9 @@ namespace ft
 			map(InputIterator first, InputIterator last,
 					const key_compare &comp = key_compare(),
 					const allocator_type &alloc = allocator_type(),
-					typename ft::iterator_traits<InputIterator>::type* = 0)
+					typename ft::iterator_traits<InputIterator>::iterator_category* = 0)
 				: _allocator(alloc), _compare(comp),
-					_valueCompare(value_compare(comp)), _root(0), _size(0)
+					_valueCompare(value_compare(comp)), _root(0), _minNode(0), _maxNode(0), _size(0)
 			{
 				this->_initSentinelNodes();
 				this->insert(first, last);
@@ -269,11 +244,10 @@ namespace ft
 			// Copy constructor
 			map(const map &x)
 				: _allocator(x._allocator), _compare(x._compare),
-					_valueCompare(x._valueCompare), _root(0), _size(0)
+					_valueCompare(x._valueCompare), _root(0), _minNode(0), _maxNode(0), _size(0)
 			{
 				this->_initSentinelNodes();
 				*this = x;
-				this->_updateSentinelNodes();
 			}
 			////////////////
 			// DESTRUCTOR //
@@ -288,15 +262,16 @@ namespace ft
 			/////////////////////////
 			map		&operator=(const map &x)
 			{
+				const_iterator		it;
+
+				if (this == &x)
+					return *this;
 				this->_destroyElements();
 				this->_compare = x._compare;
-				Node	*orig = x._lowest.nextNode();
-				for (size_t i = 0; i < x.size(); i++)
-				{
-					this->_root = this->_insert(this->_root, orig->data, 0);
-					orig = orig->nextNode();
-				}
-
+				this->_valueCompare = x._valueCompare;
+				it = x.begin();
+				this->_root = this->_buildTree(it, x.size(), 0);
+				this->_updateSentinelNodes();
 				return *this;
 			}
 
@@ -306,42 +281,42 @@ namespace ft
 			// Begin
 			iterator				begin()
 			{
-				return iterator(this->_lowest.nextNode());
+				return iterator(this->_minNode);
 			}
 			// Begin (const)
 			const_iterator			begin() const
 			{
-				return const_iterator(this->_lowest.nextNode());
+				return const_iterator(this->_minNode);
 			}
 			// End
 			iterator				end()
 			{
-				return iterator(&this->_highest);
+				return iterator(&this->_header);
 			}
 			// End (const)
 			const_iterator			end() const
 			{
-				return const_iterator(const_cast<Node *>(&this->_highest));
+				return const_iterator(const_cast<Node *>(&this->_header));
 			}
 			// Reverse begin
 			reverse_iterator		rbegin()
 			{
-				return reverse_iterator(&this->_highest);
+				return reverse_iterator(&this->_header);
 			}
 			// Reverse begin (const)
 			const_reverse_iterator	rbegin() const
 			{
-				return const_reverse_iterator(const_cast<Node *>(&this->_highest));
+				return const_reverse_iterator(const_cast<Node *>(&this->_header));
 			}
 			// Reverse end
 			reverse_iterator		rend()
 			{
-				return reverse_iterator(this->_lowest.nextNode());
+				return reverse_iterator(this->_minNode);
 			}
 			// Reverse end (const)
 			const_reverse_iterator	rend() const
 			{
-				return const_reverse_iterator(this->_lowest.nextNode());
+				return const_reverse_iterator(this->_minNode);
 			}
 
 			//////////////
@@ -369,18 +344,13 @@ namespace ft
 			// Operator []
 			mapped_type		&operator[](const key_type &k)
 			{
-				ft::pair<Key, T>	p;
-				Node				*node;
+				Node		*node;
+				Node		*parent;
+				bool		onLeft;
 
-				node = this->_findNode(k);
+				node = this->_findInsertPosition(k, parent, onLeft);
 				if (!node)
-				{
-					p.first = k;
-					p.second = mapped_type();
-					this->_root = this->_insert(this->_root, p, 0);
-					this->_updateSentinelNodes();
-					node = this->_findNode(k);
-				}
+					node = this->_insertAt(value_type(k, mapped_type()), parent, onLeft);
 				return node->data.second;
 			}
 
@@ -390,68 +360,84 @@ namespace ft
 			// Insert (Single element)
 			pair<iterator, bool>	insert(const value_type &val)
 			{
-				Node		*node;
-				bool		added;
+				ft::pair<Node *, bool>	ret;
 
-				node = this->_findNode(val.first);
-				added = (node == 0);
-				if (!node)
-				{
-					this->_root = this->_insert(this->_root, val, 0);
-					this->_updateSentinelNodes();
-					node = this->_findNode(val.first);
-				}
-				return ft::pair<iterator, bool>(iterator(node), added);
+				ret = this->_insert(val);
+				return ft::pair<iterator, bool>(iterator(ret.first), ret.second);
 			}
 			// Insert (With hint)
 			iterator				insert(iterator position, const value_type &val)
 			{
-				Node		*node;
+				Node		*hint;
+				Node		*neighbour;
 
-				(void)position;
-				node = this->_findNode(val.first);
-				if (!node)
+				hint = position.node();
+				if (this->_root == 0)
+					return this->insert(val).first;
+				if (hint == &this->_header)
 				{
-					this->_root = this->_insert(this->_root, val, 0);
-					this->_updateSentinelNodes();
-					node = this->_findNode(val.first);
+					// The hint is end(), so the key has to go after the highest key.
+					if (this->_compare(this->_maxNode->data.first, val.first))
+						return iterator(this->_insertAt(val, this->_maxNode, false));
+				}
+				else if (this->_compare(val.first, hint->data.first))
+				{
+					// The key goes before the hint, so check the node before it.
+					if (hint == this->_minNode)
+						return iterator(this->_insertAt(val, hint, true));
+					neighbour = hint->prevNode();
+					if (this->_compare(neighbour->data.first, val.first))
+					{
+						// Either the previous node has no right child, or the hint
+						// has no left child. That's where the new node goes.
+						if (neighbour->right == 0)
+							return iterator(this->_insertAt(val, neighbour, false));
+						return iterator(this->_insertAt(val, hint, true));
+					}
+				}
+				else if (this->_compare(hint->data.first, val.first))
+				{
+					// The key goes after the hint, so check the node after it.
+					if (hint == this->_maxNode)
+						return iterator(this->_insertAt(val, hint, false));
+					neighbour = hint->nextNode();
+					if (this->_compare(val.first, neighbour->data.first))
+					{
+						// Either the hint has no right child, or the next node
+						// has no left child. That's where the new node goes.
+						if (hint->right == 0)
+							return iterator(this->_insertAt(val, hint, false));
+						return iterator(this->_insertAt(val, neighbour, true));
+					}
 				}
-				return iterator(node);
+				else
+					return position;
+				// The hint was no good, so do a regular insert.
+				return this->insert(val).first;
 			}
 			// Insert (Range)
 			template <class InputIterator>
 			void					insert(InputIterator first, InputIterator last,
 					typename ft::iterator_traits<InputIterator>::iterator_category* = 0)
 			{
-				Node	*node;
-
-				while (first != last)
-				{
-					node = this->_findNode(first->first);
-					if (!node)
-					{
-						this->_root = this->_insert(this->_root, *first, 0);
-						this->_updateSentinelNodes();
-					}
-					first++;
-				}
+				this->_insertRange(first, last,
+					typename ft::iterator_traits<InputIterator>::iterator_category());
 			}
-			// Erase (By iterator)
+			// Erase (By iterator). The iterator has the node already, so no keys
+			// are compared.
 			void					erase(iterator position)
 			{
-				this->_root = this->_remove(this->_root, *position);
-				this->_updateSentinelNodes();
+				this->_eraseNode(position.node());
 			}
 			// Erase (By key)
 			size_type				erase(const key_type &k)
 			{
-				Node	*node;
+				Node		*node;
 
 				node = this->_findNode(k);
-				if (!node)
+				if (node == 0)
 					return 0;
-				this->_root = this->_remove(this->_root, node->data);
-				this->_updateSentinelNodes();
+				this->_eraseNode(node);
 				return 1;
 			}
 			// Erase (Iterator range)
@@ -468,10 +454,18 @@ namespace ft
 			// Swap
 			void					swap(map &x)
 			{
+				// value_compare has no default constructor, so ft::swap can't
+				// swap it.
+				value_compare	tmpValueCompare(this->_valueCompare);
+
 				ft::swap(this->_root, x._root);
 				ft::swap(this->_size, x._size);
-				this->_root->updateSentinelLinks(&this->_lowest, &this->_highest);
-				x._root->updateSentinelLinks(&x._lowest, &x._highest);
+				// The nodes have to go back to the allocator they came from, and
+				// the trees stay ordered by the compare they were built with.
+				ft::swap(this->_allocator, x._allocator);
+				ft::swap(this->_compare, x._compare);
+				this->_valueCompare = x._valueCompare;
+				x._valueCompare = tmpValueCompare;
 				this->_updateSentinelNodes();
 				x._updateSentinelNodes();
 			}
@@ -506,7 +500,7 @@ namespace ft
 				node = this->_findNode(k);
 				if (node)
 					return iterator(node);
-				return iterator(&this->_highest);
+				return iterator(&this->_header);
 			}
 			// Find (const)
 			const_iterator	find(const key_type &k) const
@@ -516,7 +510,7 @@ namespace ft
 				node = this->_findNode(k);
 				if (node)
 					return const_iterator(node);
-				return const_iterator(&this->_highest);
+				return const_iterator(const_cast<Node *>(&this->_header));
 			}
 			// Count
 			size_type		count(const key_type &k) const
@@ -531,62 +525,88 @@ namespace ft
 			// Lower bound
 			iterator		lower_bound(const key_type &k)
 			{
-				Node		*node;
-
-				node = this->_lowest.nextNode();
-				while (node != &this->_highest && this->_compare(node->data.first, k))
-					node = node->nextNode();
-				return iterator(node);
+				return iterator(this->_lowerBound(k));
 			}
 			// Lower bound (const)
 			const_iterator	lower_bound(const key_type &k) const
 			{
-				Node		*node;
-
-				node = this->_lowest.nextNode();
-				while (node != &this->_highest && this->_compare(node->data.first, k))
-					node = node->nextNode();
-				return const_iterator(node);
+				return const_iterator(this->_lowerBound(k));
 			}
 			// Upper bound
 			iterator		upper_bound(const key_type &k)
 			{
-				Node		*node;
-
-				node = this->_lowest.nextNode();
-				while (node != &this->_highest &&
-						(this->_compare(node->data.first, k) || node->data.first == k))
-					node = node->nextNode();
-				return iterator(node);
+				return iterator(this->_upperBound(k));
 			}
 			// Upper bound (const)
 			const_iterator	upper_bound(const key_type &k) const
 			{
-				Node		*node;
-
-				node = this->_lowest.nextNode();
-				while (node != &this->_highest &&
-						(this->_compare(node->data.first, k) || node->data.first == k))
-					node = node->nextNode();
-				return const_iterator(node);
+				return const_iterator(this->_upperBound(k));
 			}
 			// Equal range
 			ft::pair<iterator, iterator>				equal_range(const key_type &k)
 			{
-				ft::pair<iterator, iterator>	ret;
+				ft::pair<Node *, Node *>	range;
 
-				ret.first = this->lower_bound(k);
-				ret.second = this->upper_bound(k);
-				return ret;
+				range = this->_equalRange(k);
+				return ft::pair<iterator, iterator>(iterator(range.first), iterator(range.second));
 			}
 			// Equal range (const)
 			ft::pair<const_iterator, const_iterator>	equal_range(const key_type &k) const
 			{
-				ft::pair<const_iterator, const_iterator>	ret;
+				ft::pair<Node *, Node *>	range;
 
-				ret.first = this->lower_bound(k);
-				ret.second = this->upper_bound(k);
-				return ret;
+				range = this->_equalRange(k);
+				return ft::pair<const_iterator, const_iterator>(const_iterator(range.first),
+						const_iterator(range.second));
+			}
+
+			//////////////////////
+			// ORDER STATISTICS //
+			//////////////////////
+			// These only compile for a map with the order_statistics augment
+			// policy, and take logarithmic time.
+			// Nth. The element at position n, or end() if there is none.
+			iterator		nth(size_type n)
+			{
+				return iterator(this->_nthNode(n));
+			}
+			// Nth (const)
+			const_iterator	nth(size_type n) const
+			{
+				return const_iterator(this->_nthNode(n));
+			}
+			// Rank. The amount of keys that are less than k, which is the
+			// position of lower_bound(k).
+			size_type		rank(const key_type &k) const
+			{
+				Node		*node;
+				size_type	result;
+
+				node = this->_root;
+				result = 0;
+				while (node)
+				{
+					if (this->_compare(node->data.first, k))
+					{
+						result += Augment::size(node->left) + 1;
+						node = node->right;
+					}
+					else
+						node = node->left;
+				}
+				return result;
+			}
+			// Distance. The amount of elements from first up to last.
+			difference_type	distance(iterator first, iterator last) const
+			{
+				return static_cast<difference_type>(this->_position(last.node()))
+					- static_cast<difference_type>(this->_position(first.node()));
+			}
+			// Distance (const)
+			difference_type	distance(const_iterator first, const_iterator last) const
+			{
+				return static_cast<difference_type>(this->_position(last.node()))
+					- static_cast<difference_type>(this->_position(first.node()));
 			}
 
 			///////////////
@@ -601,47 +621,109 @@ namespace ft
 		// PRIVATE VARIABLES //
 		///////////////////////
 		private:
+			// Destroying a node only destroys its key and value, the destructors
+			// of Node and pair do nothing themselves.
+			static const bool	_trivialNodes = ft::is_trivially_copyable<Key>::value
+				&& ft::is_trivially_copyable<T>::value;
+
 			NodeAlloc		_allocator;		// The internal allocator.
 			key_compare		_compare;		// The function object that compares keys.
 			value_compare	_valueCompare;	// The function object that.. also compares keys.
 			Node			*_root;			// A pointer to the root of the tree.
-			Node			_lowest;		// A sentinel node to use for iterators (rend)
-			Node			_highest;		// A sentinel node to use for iterators (end)
+			Node			_header;		// The sentinel node for end(), the root hangs on its left.
+			Node			*_minNode;		// The node with the lowest key (begin).
+			Node			*_maxNode;		// The node with the highest key.
 			size_type		_size;			// The size of the list.
 
 		//////////////////////////////
 		// PRIVATE MEMBER FUNCTIONS //
 		//////////////////////////////
 		private:
-			// This function initializes the two sentinel nodes.
+			// This function initializes the sentinel node, for an empty map.
 			void			_initSentinelNodes()
 			{
-				this->_lowest.leftMost = &this->_lowest;
-				this->_lowest.rightMost = &this->_highest;
-				this->_highest.leftMost = &this->_lowest;
-				this->_highest.rightMost = &this->_highest;
+				this->_minNode = &this->_header;
+				this->_maxNode = &this->_header;
 			}
-			// This function updates the leftmost and rightmost leaves, that are used
-			// for sentinels, for iterators.
+			// This function hangs the root below the sentinel node, and finds the
+			// lowest and highest node again. For an empty map, both of those are
+			// the sentinel itself.
 			void			_updateSentinelNodes()
 			{
-				this->_lowest.right = this->_root;
-				this->_highest.right = this->_root;
+				this->_header.left = this->_root;
+				this->_minNode = &this->_header;
+				this->_maxNode = &this->_header;
+				if (this->_root == 0)
+					return ;
+				this->_root->parent = &this->_header;
+				this->_minNode = this->_root;
+				this->_maxNode = this->_root;
+				while (this->_minNode->left)
+					this->_minNode = this->_minNode->left;
+				while (this->_maxNode->right)
+					this->_maxNode = this->_maxNode->right;
 			}
-			// This function destroys all map nodes.
+			// This function destroys all map nodes. If destroying them does
+			// nothing, and the allocator can free all of its memory at once, the
+			// nodes are not visited at all.
 			void			_destroyElements()
 			{
-				this->_recursiveDestroy(this->_root);
+				if (!(_trivialNodes && _releaseAll(this->_allocator)))
+					this->_destroyTree(this->_root);
 				this->_root = 0;
+				this->_size = 0;
+				this->_updateSentinelNodes();
 			}
-			// This function recursively destroys and deallocates a node and its children.
-			void			_recursiveDestroy(Node *node)
+			// This function destroys and deallocates a node and all nodes below
+			// it, without recursion and without a separate stack. It follows the
+			// left children down. A node with a right child is kept until the walk
+			// reaches a leaf, and until then it is on a stack of its own that is
+			// linked through the parent pointers, since those aren't needed any
+			// more. At a leaf, the walk goes on with the right child of the node
+			// on top of that stack.
+			void			_destroyTree(Node *node)
 			{
-				if (!node)
-					return ;
-				this->_recursiveDestroy(node->left);
-				this->_recursiveDestroy(node->right);
-				this->_destroyNode(node);
+				Node	*pending;
+				Node	*next;
+
+				pending = 0;
+				while (node)
+				{
+					next = node->left;
+					if (node->right)
+					{
+						node->parent = pending;
+						pending = node;
+					}
+					else
+						this->_freeNode(node);
+					if (!next && pending)
+					{
+						node = pending;
+						next = node->right;
+						pending = node->parent;
+						this->_freeNode(node);
+					}
+					node = next;
+				}
+			}
+			// This function destroys and deallocates a node, without counting it.
+			void			_freeNode(Node *node)
+			{
+				this->_allocator.destroy(node);
+				this->_allocator.deallocate(node, 1);
+			}
+			// These functions free all nodes at once, if the allocator can. Only
+			// a pool allocator that no other container of its type uses can.
+			template <class A>
+			static bool		_releaseAll(A &)
+			{
+				return false;
+			}
+			template <class U, std::size_t N>
+			static bool		_releaseAll(ft::pool_allocator<U, N> &alloc)
+			{
+				return alloc.release_all();
 			}
 			// This function uses the allocator to destruct and deallocate a Node.
 			void			_destroyNode(Node *node)
@@ -658,8 +740,7 @@ namespace ft
 				node = this->_allocator.allocate(1);
 				this->_allocator.construct(node, val);
 				node->parent = parent;
-				node->leftMost = &this->_lowest;
-				node->rightMost = &this->_highest;
+				Augment::update(*node, this->_compare);
 				this->_size++;
 				return node;
 			}
@@ -691,8 +772,8 @@ namespace ft
 				}
 
 				// Update the heights.
-				node->updateHeight();
-				rightChild->updateHeight();
+				node->update(this->_compare);
+				rightChild->update(this->_compare);
 			}
 			// This function will perform a right rotation at a certain node.
 			void		_rightRotate(Node *node)
@@ -722,177 +803,374 @@ namespace ft
 				}
 
 				// Update the heights.
-				node->updateHeight();
-				leftChild->updateHeight();
+				node->update(this->_compare);
+				leftChild->update(this->_compare);
 			}
-			// This function will insert a new Node into the map.
-			Node			*_insert(Node *node, const value_type &val, Node *parent)
+			// This function creates a node for val and hangs it below parent, on
+			// the side given. The caller has to make sure that is the right spot.
+			// The tree is then rebalanced from the parent upwards. A parent of 0
+			// means the tree is empty, and the node becomes the root.
+			Node			*_insertAt(const value_type &val, Node *parent, bool onLeft)
 			{
-				int			balance;
-
-				// Base case, if node is NULL we add a node here.
-				if (node == 0)
-					return this->_createNode(val, parent);
-
-				// Find the spot to insert this node.
-				if (this->_compare(val.first, node->data.first))
-					node->left = this->_insert(node->left, val, node);
-				else if (val.first != node->data.first)
-					node->right = this->_insert(node->right, val, node);
-				else
-					return node;
-
-				// Update the height (this will happen recursively from bottom to top).
-				node->updateHeight();
+				Node	*node;
 
-				// Rebalance if necessary.
-				balance = node->getBalance();
-				if (balance > 1 && this->_compare(val.first, node->left->data.first))
+				node = this->_createNode(val, parent);
+				if (parent == 0)
 				{
-					// Left left case.
-					this->_rightRotate(node);
-					return node->parent;
-				}
-				else if (balance > 1)
-				{
-					// Left right case
-					this->_leftRotate(node->left);
-					this->_rightRotate(node);
-					return node->parent;
+					this->_root = node;
+					this->_updateSentinelNodes();
+					return node;
 				}
-				else if (balance < -1 && this->_compare(val.first, node->right->data.first))
+				if (onLeft)
 				{
-					// Right left case
-					this->_rightRotate(node->right);
-					this->_leftRotate(node);
-					return node->parent;
+					parent->left = node;
+					if (parent == this->_minNode)
+						this->_minNode = node;
 				}
-				else if (balance < -1)
+				else
 				{
-					// Right right case
-					this->_leftRotate(node);
-					return node->parent;
+					parent->right = node;
+					if (parent == this->_maxNode)
+						this->_maxNode = node;
 				}
+				this->_rebalanceUp(parent);
 				return node;
 			}
-			// This function will remove a Node from the map.
-			Node			*_remove(Node *node, const value_type &val)
+			// This function walks up the tree from a node that just got a new leaf
+			// below it, or lost a node below it, updating the heights and rotating
+			// where necessary. Once a subtree is back at its old height, no
+			// rotations are needed above it, only the augment data still changes.
+			void			_rebalanceUp(Node *node)
 			{
+				Node		*parent;
+				int			oldHeight;
 				int			balance;
 
-				// Base case, if we arrive at 0 we haven't found the node to delete.
-				if (node == 0)
-					return 0;
-
-				// Find the node to delete.
-				if (this->_compare(val.first, node->data.first))
-					node->left = this->_remove(node->left, val);
-				else if (val.first != node->data.first)
-					node->right = this->_remove(node->right, val);
-				else
+				while (node != &this->_header)
 				{
-					// We've found the node to delete.
-					// Decide what to do based on the number of child nodes.
-					if (node->left == 0 && node->right == 0)
+					parent = node->parent;
+					oldHeight = node->height;
+					node->update(this->_compare);
+					balance = node->getBalance();
+					if (balance > 1)
 					{
-						// No children, delete the node.
-						// Update the parent.
-						if (node->parent)
-						{
-							if (node->isOnLeft())
-								node->parent->left = 0;
-							else
-								node->parent->right = 0;
-						}
-						this->_destroyNode(node);
-						node = 0;
+						// Left right case first needs a rotation of the left child.
+						if (node->left->getBalance() < 0)
+							this->_leftRotate(node->left);
+						this->_rightRotate(node);
+						node = node->parent;
 					}
-					else if (node->left == 0 || node->right == 0)
+					else if (balance < -1)
 					{
-						// One child. Remove the node and put the child in its place.
-						Node	*child = (node->left == 0) ? node->right : node->left;
-
-						// Update the parent.
-						child->parent = node->parent;
-						if (node->parent)
-						{
-							if (node->isOnLeft())
-								node->parent->left = child;
-							else
-								node->parent->right = child;
-						}
-						this->_destroyNode(node);
-						node = child;
+						// Right left case first needs a rotation of the right child.
+						if (node->right->getBalance() > 0)
+							this->_rightRotate(node->right);
+						this->_leftRotate(node);
+						node = node->parent;
+					}
+					if (parent == &this->_header)
+						this->_root = node;
+					if (node->height == oldHeight)
+					{
+						this->_augmentUp(parent);
+						return ;
 					}
+					node = parent;
+				}
+			}
+			// This function updates the augment data of a node and all nodes
+			// above it.
+			void			_augmentUp(Node *node)
+			{
+				if (!Augment::enabled)
+					return ;
+				while (node != &this->_header)
+				{
+					Augment::update(*node, this->_compare);
+					node = node->parent;
+				}
+			}
+			// This function will insert val into the map, unless its key is already
+			// in there. It walks down the tree only once. It returns the node with
+			// the key, and whether that node was just created.
+			ft::pair<Node *, bool>	_insert(const value_type &val)
+			{
+				Node		*node;
+				Node		*parent;
+				bool		onLeft;
+
+				node = this->_findInsertPosition(val.first, parent, onLeft);
+				if (node)
+					return ft::pair<Node *, bool>(node, false);
+				return ft::pair<Node *, bool>(this->_insertAt(val, parent, onLeft), true);
+			}
+			// This function walks down from the root looking for k. If it is found,
+			// its node is returned. If not, it returns 0, and parent and onLeft are
+			// set to the spot where a node with key k should be hung.
+			// It compares once per level: the last node it went right at is the
+			// highest key that isn't greater than k, so k is in the tree only if
+			// that key isn't less than k either.
+			Node			*_findInsertPosition(const key_type &k, Node *&parent, bool &onLeft) const
+			{
+				Node		*node;
+				Node		*notGreater;
+
+				node = this->_root;
+				notGreater = 0;
+				parent = 0;
+				onLeft = false;
+				while (node)
+				{
+					parent = node;
+					onLeft = this->_compare(k, node->data.first);
+					if (onLeft)
+						node = node->left;
 					else
 					{
-						// Two children
-						// Find this node's replacement. It will be the lowest value
-						// in the right subtree.
-						Node	*replacement = node->right;
-						while (replacement->left)
-							replacement = replacement->left;
-
-						// Copy the replacement's key to this node.
-						this->_swapNodes(node, replacement);
-
-						// Continue the deletion recursively with the new key.
-						replacement->right = this->_remove(replacement->right, node->data);
-						node = replacement;
+						notGreater = node;
+						node = node->right;
 					}
 				}
+				if (notGreater && !this->_compare(notGreater->data.first, k))
+					return notGreater;
+				return 0;
+			}
+			// This function builds a balanced subtree out of the next n elements
+			// of a sorted range, and moves first past them. Both halves of every
+			// subtree differ in size by at most one, so the result is a valid AVL
+			// tree, built in linear time without any rotations.
+			template <class InputIterator>
+			Node			*_buildTree(InputIterator &first, size_type n, Node *parent)
+			{
+				Node		*node;
+				Node		*left;
 
-				// If this was a leaf, return.
-				if (node == 0)
+				if (n == 0)
 					return 0;
+				left = this->_buildTree(first, n / 2, 0);
+				node = this->_createNode(*first, parent);
+				first++;
+				node->left = left;
+				if (left)
+					left->parent = node;
+				node->right = this->_buildTree(first, n - n / 2 - 1, node);
+				node->update(this->_compare);
+				return node;
+			}
+			// This function inserts a range that can only be walked once. It
+			// hints at the end, so ascending runs stay cheap.
+			template <class InputIterator>
+			void			_insertRange(InputIterator first, InputIterator last, ft::input_iterator_tag)
+			{
+				while (first != last)
+				{
+					this->insert(this->end(), *first);
+					first++;
+				}
+			}
+			// This function inserts a range that can be walked more than once. A
+			// sorted range going into an empty map can be built directly.
+			template <class ForwardIterator>
+			void			_insertRange(ForwardIterator first, ForwardIterator last, ft::forward_iterator_tag)
+			{
+				size_type	n;
 
-				// Update the height.
-				node->updateHeight();
-
-				// See if we need to rebalance.
-				balance = node->getBalance();
-				if (balance > 1 && node->left->getBalance() >= 0)
+				if (this->_root == 0 && this->_isSortedRange(first, last, n))
+				{
+					this->_root = this->_buildTree(first, n, 0);
+					this->_updateSentinelNodes();
+					return ;
+				}
+				this->_insertRange(first, last, ft::input_iterator_tag());
+			}
+			// The iterators of the std library have tags of their own.
+			template <class InputIterator>
+			void			_insertRange(InputIterator first, InputIterator last, std::input_iterator_tag)
+			{
+				this->_insertRange(first, last, ft::input_iterator_tag());
+			}
+			template <class ForwardIterator>
+			void			_insertRange(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+			{
+				this->_insertRange(first, last, ft::forward_iterator_tag());
+			}
+			// This function checks if the keys in a range are strictly ascending,
+			// and counts the elements while doing so. It only dereferences the
+			// iterators, a forward iterator doesn't need an -> operator.
+			template <class ForwardIterator>
+			bool			_isSortedRange(ForwardIterator first, ForwardIterator last, size_type &n) const
+			{
+				ForwardIterator	prev;
+
+				n = 0;
+				if (first == last)
+					return true;
+				prev = first;
+				n++;
+				while (++first != last)
 				{
-					this->_rightRotate(node);
-					return node->parent;
+					if (!this->_compare((*prev).first, (*first).first))
+						return false;
+					prev = first;
+					n++;
 				}
-				else if (balance > 1)
+				return true;
+			}
+			// This function will unlink a node from the tree and destroy it. A
+			// node with two children first trades places with the next node, which
+			// has no left child, so the node to unlink always has one child at
+			// most. That child takes its place, and the tree is rebalanced from
+			// the parent upwards. Only the parent pointers are followed, so no
+			// keys are compared.
+			void			_eraseNode(Node *node)
+			{
+				Node		*parent;
+				Node		*child;
+				Node		*next;
+
+				if (node->left && node->right)
 				{
-					this->_leftRotate(node->left);
-					this->_rightRotate(node);
-					return node->parent;
+					next = node->nextNode();
+					this->_swapNodes(node, next);
+					if (next->parent == &this->_header)
+						this->_root = next;
 				}
-				else if (balance < -1 && node->right->getBalance() > 0)
+				parent = node->parent;
+				child = (node->left == 0) ? node->right : node->left;
+				if (child)
+					child->parent = parent;
+				if (node->isOnLeft())
+					parent->left = child;
+				else
+					parent->right = child;
+				if (parent == &this->_header)
+					this->_root = child;
+
+				// The lowest node has no left child, so the next one is the lowest
+				// in its right subtree, or its parent. The same goes for the
+				// highest node the other way around.
+				if (node == this->_minNode)
 				{
-					this->_rightRotate(node->right);
-					this->_leftRotate(node);
-					return node->parent;
+					this->_minNode = (child) ? child : parent;
+					while (child && this->_minNode->left)
+						this->_minNode = this->_minNode->left;
 				}
-				else if (balance < -1)
+				if (node == this->_maxNode)
 				{
-					this->_leftRotate(node);
-					return node->parent;
+					this->_maxNode = (child) ? child : parent;
+					while (child && this->_maxNode->right)
+						this->_maxNode = this->_maxNode->right;
 				}
-
-				// Return the node.
-				return node;
+				this->_destroyNode(node);
+				this->_rebalanceUp(parent);
 			}
-			// This function will try to find a node with the key given.
+			// This function will try to find a node with the key given, and
+			// returns 0 if there is none. It compares once per level on the way
+			// down to the lower bound, and once more to see if that has key k.
 			Node			*_findNode(const key_type &k) const
 			{
 				Node		*node;
 
+				node = this->_lowerBound(k);
+				if (node != &this->_header && !this->_compare(k, node->data.first))
+					return node;
+				return 0;
+			}
+			// This function will find the first node with a key that is not less
+			// than k, walking down from the root. If there is none, it returns
+			// the end sentinel.
+			Node			*_lowerBound(const key_type &k) const
+			{
+				Node		*node;
+				Node		*result;
+
 				node = this->_root;
+				result = const_cast<Node *>(&this->_header);
+				while (node)
+				{
+					if (this->_compare(node->data.first, k))
+						node = node->right;
+					else
+					{
+						result = node;
+						node = node->left;
+					}
+				}
+				return result;
+			}
+			// This function will find the first node with a key that is greater
+			// than k, walking down from the root. If there is none, it returns
+			// the end sentinel.
+			Node			*_upperBound(const key_type &k) const
+			{
+				Node		*node;
+				Node		*result;
+
+				node = this->_root;
+				result = const_cast<Node *>(&this->_header);
 				while (node)
 				{
-					if (k == node->data.first)
-						return node;
 					if (this->_compare(k, node->data.first))
+					{
+						result = node;
 						node = node->left;
+					}
 					else
 						node = node->right;
 				}
-				return node;
+				return result;
+			}
+			// This function will find the lower and upper bound of k with a single
+			// descent. Since keys are unique, the upper bound is either the lower
+			// bound itself, or the node right after it.
+			ft::pair<Node *, Node *>	_equalRange(const key_type &k) const
+			{
+				Node		*lower;
+
+				lower = this->_lowerBound(k);
+				if (lower != &this->_header && !this->_compare(k, lower->data.first))
+					return ft::pair<Node *, Node *>(lower, lower->nextNode());
+				return ft::pair<Node *, Node *>(lower, lower);
+			}
+			// This function finds the node at position n, or the end sentinel.
+			Node			*_nthNode(size_type n) const
+			{
+				Node		*node;
+				size_type	leftSize;
+
+				node = this->_root;
+				while (node)
+				{
+					leftSize = Augment::size(node->left);
+					if (n < leftSize)
+						node = node->left;
+					else if (n == leftSize)
+						return node;
+					else
+					{
+						n -= leftSize + 1;
+						node = node->right;
+					}
+				}
+				return const_cast<Node *>(&this->_header);
+			}
+			// This function returns the position of a node: the nodes in its left
+			// subtree come before it, and so does every node that it is on the
+			// right of, with its left subtree. The end sentinel comes after all.
+			size_type		_position(Node *node) const
+			{
+				size_type	result;
+
+				if (node == &this->_header)
+					return this->_size;
+				result = Augment::size(node->left);
+				while (node->parent != &this->_header)
+				{
+					if (!node->isOnLeft())
+						result += Augment::size(node->parent->left) + 1;
+					node = node->parent;
+				}
+				return result;
 			}
 			// This function will swap two nodes (for deletion purposes)
 			void		_swapNodes(Node *n1, Node *n2)
@@ -928,17 +1206,24 @@ namespace ft
 				// Swap the heights of the nodes.
 				ft::swap(n1->height, n2->height);
 			}
+
+		/////////////////////////
+		// FRIEND DECLARATIONS //
+		/////////////////////////
+		// The interval map searches the tree itself, using the augment data.
+		template <class Point, class U, class C, class A>
+		friend class interval_map;
 	};
 
 	//////////////////////////
 	// RELATIONAL OPERATORS //
 	//////////////////////////
 	// == operator
-	template <class Key, class T, class Compare, class Alloc>
-	bool		operator==(const map<Key, T, Compare, Alloc> &lhs,
-							const map<Key, T, Compare, Alloc> &rhs)
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool		operator==(const map<Key, T, Compare, Alloc, Augment> &lhs,
+							const map<Key, T, Compare, Alloc, Augment> &rhs)
 	{
-		typename map<Key, T, Compare, Alloc>::const_iterator	lhsit, rhsit;
+		typename map<Key, T, Compare, Alloc, Augment>::const_iterator	lhsit, rhsit;
 
 		if (lhs.size() != rhs.size())
 			return false;
@@ -954,44 +1239,44 @@ namespace ft
 		return true;
 	}
 	// != operator
-	template <class Key, class T, class Compare, class Alloc>
-	bool		operator!=(const map<Key, T, Compare, Alloc> &lhs,
-							const map<Key, T, Compare, Alloc> &rhs)
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool		operator!=(const map<Key, T, Compare, Alloc, Augment> &lhs,
+							const map<Key, T, Compare, Alloc, Augment> &rhs)
 	{
 		return !(lhs == rhs);
 	}
 	// < operator
-	template <class Key, class T, class Compare, class Alloc>
-	bool		operator<(const map<Key, T, Compare, Alloc> &lhs,
-							const map<Key, T, Compare, Alloc> &rhs)
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool		operator<(const map<Key, T, Compare, Alloc, Augment> &lhs,
+							const map<Key, T, Compare, Alloc, Augment> &rhs)
 	{
 		return lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 	}
 	// <= operator
-	template <class Key, class T, class Compare, class Alloc>
-	bool		operator<=(const map<Key, T, Compare, Alloc> &lhs,
-							const map<Key, T, Compare, Alloc> &rhs)
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool		operator<=(const map<Key, T, Compare, Alloc, Augment> &lhs,
+							const map<Key, T, Compare, Alloc, Augment> &rhs)
 	{
 		return !(rhs < lhs);
 	}
 	// > operator
-	template <class Key, class T, class Compare, class Alloc>
-	bool		operator>(const map<Key, T, Compare, Alloc> &lhs,
-							const map<Key, T, Compare, Alloc> &rhs)
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool		operator>(const map<Key, T, Compare, Alloc, Augment> &lhs,
+							const map<Key, T, Compare, Alloc, Augment> &rhs)
 	{
 		return (rhs < lhs);
 	}
 	// >= operator
-	template <class Key, class T, class Compare, class Alloc>
-	bool		operator>=(const map<Key, T, Compare, Alloc> &lhs,
-							const map<Key, T, Compare, Alloc> &rhs)
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool		operator>=(const map<Key, T, Compare, Alloc, Augment> &lhs,
+							const map<Key, T, Compare, Alloc, Augment> &rhs)
 	{
 		return !(lhs < rhs);
 	}
 	// Swap
-	template <class Key, class T, class Compare, class Alloc>
-	void		swap(map<Key, T, Compare, Alloc> &lhs,
-					map<Key, T, Compare, Alloc> &rhs)
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	void		swap(map<Key, T, Compare, Alloc, Augment> &lhs,
+					map<Key, T, Compare, Alloc, Augment> &rhs)
 	{
 		lhs.swap(rhs);
 	}
@@ -0,0 +1,223 @@
+#ifndef MPMC_QUEUE_HPP
+# define MPMC_QUEUE_HPP
+
+# include <cstddef>				// size_t, ptrdiff_t
+# include <memory>				// allocator
+# include "atomic.hpp"			// atomic operations, cache_line_size
+# include "wait_strategy.hpp"	// spin_wait
+
+namespace ft
+{
+	// A bounded queue that any number of threads can push to and pop from
+	// without taking a lock. The elements are kept in a ring buffer of N
+	// slots, and every slot has a sequence number that says whose turn it is:
+	// - sequence == position: the slot is free for the push at that position.
+	// - sequence == position + 1: the slot holds the element for the pop at
+	//   that position.
+	// A thread claims a position by moving the tail (push) or the head (pop)
+	// forward with a compare and swap, and then hands the slot over by setting
+	// its sequence. After pushing, the sequence is position + 1, and after
+	// popping it's position + N, which is the next push to use the slot.
+	// The blocking push and pop spin for a while, and then use the Wait
+	// strategy, see wait_strategy.hpp.
+	template <class T, std::size_t N, class Wait = ft::spin_wait>
+	class mpmc_queue
+	{
+		//////////////////
+		// MEMBER TYPES //
+		//////////////////
+		public:
+			typedef T					value_type;
+			typedef std::size_t			size_type;
+			typedef T&					reference;
+			typedef const T&			const_reference;
+			typedef Wait				wait_strategy;
+
+		//////////////////////
+		// MEMBER FUNCTIONS //
+		//////////////////////
+		public:
+			//////////////////
+			// CONSTRUCTORS //
+			//////////////////
+			// Default constructor
+			mpmc_queue() : _head(0), _tail(0)
+			{
+				this->_buffer = this->_allocator.allocate(N);
+				this->_sequences = this->_sequenceAllocator.allocate(N);
+				for (size_type i = 0; i < N; i++)
+					this->_sequences[i] = i;
+			}
+			////////////////
+			// DESTRUCTOR //
+			////////////////
+			~mpmc_queue()
+			{
+				for (size_type i = this->_head; i != this->_tail; i++)
+					this->_allocator.destroy(&this->_buffer[i % N]);
+				this->_allocator.deallocate(this->_buffer, N);
+				this->_sequenceAllocator.deallocate(this->_sequences, N);
+			}
+
+			//////////////
+			// CAPACITY //
+			//////////////
+			// Empty. Only exact when no other thread uses the queue.
+			bool		empty() const
+			{
+				return (this->size() == 0);
+			}
+			// Size. Only exact when no other thread uses the queue.
+			size_type	size() const
+			{
+				size_type	head = ft::atomic_load(&this->_head, ft::memory_order_acquire);
+				size_type	tail = ft::atomic_load(&this->_tail, ft::memory_order_acquire);
+
+				return (tail > head) ? tail - head : 0;
+			}
+			// Capacity
+			size_type	capacity() const
+			{
+				return N;
+			}
+
+			///////////////
+			// MODIFIERS //
+			///////////////
+			// Try push. Returns false if the queue is full.
+			bool		try_push(const value_type &val)
+			{
+				size_type	pos;
+				size_type	slot;
+
+				if (!this->_claim(this->_tail, 0, pos))
+					return false;
+				slot = pos % N;
+				this->_allocator.construct(&this->_buffer[slot], val);
+				ft::atomic_store(&this->_sequences[slot], pos + 1, ft::memory_order_release);
+				this->_notEmpty.notify();
+				return true;
+			}
+			// Try pop. Moves the oldest element into val. Returns false if the
+			// queue is empty.
+			bool		try_pop(value_type &val)
+			{
+				size_type	pos;
+				size_type	slot;
+
+				if (!this->_claim(this->_head, 1, pos))
+					return false;
+				slot = pos % N;
+				val = this->_buffer[slot];
+				this->_allocator.destroy(&this->_buffer[slot]);
+				ft::atomic_store(&this->_sequences[slot], pos + N, ft::memory_order_release);
+				this->_notFull.notify();
+				return true;
+			}
+			// Push. Waits until there is room.
+			void		push(const value_type &val)
+			{
+				unsigned int	ticket;
+
+				for (size_type spins = 0; !this->try_push(val); spins++)
+				{
+					if (spins < _spinLimit)
+					{
+						ft::cpu_relax();
+						continue ;
+					}
+					ticket = this->_notFull.prepare_wait();
+					if (this->try_push(val))
+					{
+						this->_notFull.finish_wait();
+						return ;
+					}
+					this->_notFull.wait(ticket);
+					this->_notFull.finish_wait();
+				}
+			}
+			// Pop. Waits until there is an element, and moves it into val.
+			void		pop(value_type &val)
+			{
+				unsigned int	ticket;
+
+				for (size_type spins = 0; !this->try_pop(val); spins++)
+				{
+					if (spins < _spinLimit)
+					{
+						ft::cpu_relax();
+						continue ;
+					}
+					ticket = this->_notEmpty.prepare_wait();
+					if (this->try_pop(val))
+					{
+						this->_notEmpty.finish_wait();
+						return ;
+					}
+					this->_notEmpty.wait(ticket);
+					this->_notEmpty.finish_wait();
+				}
+			}
+
+		///////////////////////
+		// PRIVATE VARIABLES //
+		///////////////////////
+		private:
+			// The amount of times push and pop spin before they wait.
+			static const size_type		_spinLimit = 128;
+
+			// Keeps the indices off the cache line of whatever is in front of
+			// the queue in memory.
+			char					_padFront[ft::cache_line_size];
+			// Moved by the consumers.
+			size_type				_head;
+			char					_padHead[ft::cache_line_size - sizeof(size_type)];
+			// Moved by the producers.
+			size_type				_tail;
+			char					_padTail[ft::cache_line_size - sizeof(size_type)];
+			// Only read after construction.
+			std::allocator<T>			_allocator;
+			std::allocator<size_type>	_sequenceAllocator;
+			T							*_buffer;
+			size_type					*_sequences;
+			Wait						_notEmpty;
+			Wait						_notFull;
+
+			// A queue can't be copied while other threads are using it.
+			mpmc_queue(const mpmc_queue &);
+			mpmc_queue	&operator=(const mpmc_queue &);
+
+		//////////////////////////////
+		// PRIVATE MEMBER FUNCTIONS //
+		//////////////////////////////
+		private:
+			// This function claims the next position of index, which is the tail
+			// for a push (offset 0) or the head for a pop (offset 1). It fails if
+			// the slot at that position isn't ready yet, which means the queue is
+			// full or empty.
+			bool		_claim(size_type &index, size_type offset, size_type &pos)
+			{
+				std::ptrdiff_t	diff;
+				size_type		sequence;
+
+				pos = ft::atomic_load(&index, ft::memory_order_relaxed);
+				while (true)
+				{
+					sequence = ft::atomic_load(&this->_sequences[pos % N], ft::memory_order_acquire);
+					diff = static_cast<std::ptrdiff_t>(sequence - (pos + offset));
+					if (diff == 0)
+					{
+						if (ft::atomic_compare_exchange(&index, pos, pos + 1,
+								ft::memory_order_relaxed, ft::memory_order_relaxed))
+							return true;
+					}
+					else if (diff < 0)
+						return false;
+					else
+						pos = ft::atomic_load(&index, ft::memory_order_relaxed);
+				}
+			}
+	};
+}
+
+#endif
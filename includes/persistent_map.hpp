@@ -0,0 +1,728 @@
+#ifndef PERSISTENT_MAP_HPP
+# define PERSISTENT_MAP_HPP
+
+# include <cstddef>						// size_t, ptrdiff_t
+# include <memory>						// allocator
+# include "PersistentIterator.hpp"		// PersistentIterator class
+# include "atomic.hpp"					// atomic_load, atomic_fetch_add
+# include "pair.hpp"					// pair class
+# include "utils.hpp"					// less predicate
+
+namespace ft
+{
+	// A map whose copies share their nodes. It is an AVL tree like ft::map,
+	// but every node counts the trees that point to it, and nodes that are
+	// shared are never changed. A change copies the nodes on the path down to
+	// the key it changes, and hangs the copies in a new tree, which shares
+	// everything else with the old one. A node that only this map points to
+	// is changed in place instead, so a map that is never copied doesn't copy
+	// any nodes either.
+	// That makes copying O(1): snapshot() only points to the same root. A
+	// snapshot can be handed to another thread and read while this map keeps
+	// changing, since the nodes it can reach stay the same. The counts are
+	// atomic for that reason. A single map is still only safe to use from one
+	// thread at a time, and the allocator has to be safe to use from every
+	// thread that destroys a copy.
+	// The elements can't be changed through an iterator, because they may be
+	// shared. insert_or_assign changes the value of a key.
+	template <class Key,
+			 class T,
+			 class Compare = less<Key>,
+			 class Alloc = std::allocator<ft::pair<const Key, T> > >
+	class persistent_map
+	{
+		// Forward declaration of Node
+		private:
+			class Node;
+
+		//////////////////
+		// MEMBER TYPES //
+		//////////////////
+		public:
+			typedef Key														key_type;
+			typedef T														mapped_type;
+			typedef ft::pair<const key_type, mapped_type>					value_type;
+			typedef Compare													key_compare;
+			typedef Alloc													allocator_type;
+			typedef typename allocator_type::reference						reference;
+			typedef typename allocator_type::const_reference				const_reference;
+			typedef typename allocator_type::pointer						pointer;
+			typedef typename allocator_type::const_pointer					const_pointer;
+			typedef PersistentIterator<Node, value_type>					iterator;
+			typedef PersistentIterator<Node, value_type>					const_iterator;
+			typedef std::ptrdiff_t											difference_type;
+			typedef std::size_t												size_type;
+			typedef typename allocator_type::template rebind<Node>::other	NodeAlloc;
+
+		//////////
+		// NODE //
+		//////////
+		// A node has no parent, because it can be in several trees at once.
+		// Refs is the amount of pointers to the node: from the roots of maps,
+		// and from the nodes above it.
+		private:
+			class Node
+			{
+				public:
+					// Parameterized constructor
+					Node(value_type const &val)
+						: left(0), right(0), data(val), refs(1), height(1)
+					{
+					}
+					// Destructor
+					~Node()
+					{
+					}
+					// Update the height of this node in the tree.
+					void		updateHeight()
+					{
+						int		left;
+						int		right;
+
+						left = heightOf(this->left);
+						right = heightOf(this->right);
+						this->height = 1 + ((left < right) ? right : left);
+					}
+					// Get the balance of this node.
+					int			getBalance() const
+					{
+						return (heightOf(this->left) - heightOf(this->right));
+					}
+					// The height of a subtree, 0 for an empty one.
+					static int	heightOf(const Node *node)
+					{
+						if (node == 0)
+							return 0;
+						return node->height;
+					}
+
+					// Public variables
+					Node			*left;
+					Node			*right;
+					value_type		data;
+					std::size_t		refs;
+					int				height;
+			};
+
+		//////////////////////
+		// MEMBER FUNCTIONS //
+		//////////////////////
+		public:
+			//////////////////
+			// CONSTRUCTORS //
+			//////////////////
+			// Default constructor
+			explicit persistent_map(const key_compare &comp = key_compare(),
+					const allocator_type &alloc = allocator_type())
+				: _allocator(alloc), _compare(comp), _root(0), _size(0)
+			{
+			}
+			// Range constructor
+			template <class InputIterator>
+			persistent_map(InputIterator first, InputIterator last,
+					const key_compare &comp = key_compare(),
+					const allocator_type &alloc = allocator_type(),
+					typename ft::iterator_traits<InputIterator>::iterator_category* = 0)
+				: _allocator(alloc), _compare(comp), _root(0), _size(0)
+			{
+				this->insert(first, last);
+			}
+			// Copy constructor. Shares all nodes with x.
+			persistent_map(const persistent_map &x)
+				: _allocator(x._allocator), _compare(x._compare), _root(x._root), _size(x._size)
+			{
+				this->_retain(this->_root);
+			}
+			////////////////
+			// DESTRUCTOR //
+			////////////////
+			virtual ~persistent_map()
+			{
+				this->_release(this->_root);
+			}
+
+			/////////////////////////
+			// ASSIGNMENT OVERLOAD //
+			/////////////////////////
+			// Shares all nodes with x, and lets go of the old ones.
+			persistent_map	&operator=(const persistent_map &x)
+			{
+				this->_retain(x._root);
+				this->_release(this->_root);
+				this->_compare = x._compare;
+				this->_root = x._root;
+				this->_size = x._size;
+				return *this;
+			}
+
+			//////////////
+			// SNAPSHOT //
+			//////////////
+			// Snapshot. A copy of the map as it is now, in O(1). Later changes
+			// to this map don't show up in it, and the other way around.
+			persistent_map	snapshot() const
+			{
+				return persistent_map(*this);
+			}
+
+			///////////////
+			// ITERATORS //
+			///////////////
+			// Begin
+			const_iterator	begin() const
+			{
+				const_iterator	it;
+
+				it.push_left(this->_root);
+				return it;
+			}
+			// End
+			const_iterator	end() const
+			{
+				return const_iterator();
+			}
+
+			//////////////
+			// CAPACITY //
+			//////////////
+			// Empty
+			bool		empty() const
+			{
+				return (this->_size == 0);
+			}
+			// Size
+			size_type	size() const
+			{
+				return this->_size;
+			}
+			// Max size
+			size_type	max_size() const
+			{
+				return this->_allocator.max_size();
+			}
+
+			///////////////
+			// MODIFIERS //
+			///////////////
+			// Insert (Single element). Copies the path down to the new node.
+			// The iterator is built from that path, unless the tree rotated.
+			ft::pair<iterator, bool>	insert(const value_type &val)
+			{
+				Node		*path[iterator::max_depth];
+				int			depth;
+				int			found;
+
+				found = this->_findPath(val.first, path, depth);
+				if (found != -1)
+					return ft::pair<iterator, bool>(this->_iteratorAt(path, found), false);
+				if (this->_insertAt(val, path, depth))
+					return ft::pair<iterator, bool>(this->_iteratorAt(path, depth), true);
+				return ft::pair<iterator, bool>(this->find(val.first), true);
+			}
+			// Insert (Range)
+			template <class InputIterator>
+			void						insert(InputIterator first, InputIterator last,
+					typename ft::iterator_traits<InputIterator>::iterator_category* = 0)
+			{
+				while (first != last)
+				{
+					this->_insertValue(*first);
+					first++;
+				}
+			}
+			// Insert or assign. Inserts k with obj, or gives k the value obj if
+			// it is in the map already.
+			ft::pair<iterator, bool>	insert_or_assign(const key_type &k, const mapped_type &obj)
+			{
+				Node		*path[iterator::max_depth];
+				int			depth;
+				int			found;
+
+				found = this->_findPath(k, path, depth);
+				if (found == -1)
+				{
+					if (this->_insertAt(value_type(k, obj), path, depth))
+						return ft::pair<iterator, bool>(this->_iteratorAt(path, depth), true);
+					return ft::pair<iterator, bool>(this->find(k), true);
+				}
+				this->_uniquePath(path, found + 1);
+				path[found]->data.second = obj;
+				return ft::pair<iterator, bool>(this->_iteratorAt(path, found), false);
+			}
+			// Erase (By iterator)
+			void						erase(iterator position)
+			{
+				this->erase(position->first);
+			}
+			// Erase (By key). Copies the path down to the node.
+			size_type					erase(const key_type &k)
+			{
+				Node		*path[iterator::max_depth];
+				int			depth;
+				int			found;
+
+				found = this->_findPath(k, path, depth);
+				if (found == -1)
+					return 0;
+				this->_removeAt(path, found + 1);
+				return 1;
+			}
+			// Swap
+			void						swap(persistent_map &x)
+			{
+				NodeAlloc		tmpAllocator;
+				key_compare		tmpCompare;
+				Node			*tmpRoot;
+				size_type		tmpSize;
+
+				tmpAllocator = this->_allocator;
+				tmpCompare = this->_compare;
+				tmpRoot = this->_root;
+				tmpSize = this->_size;
+				this->_allocator = x._allocator;
+				this->_compare = x._compare;
+				this->_root = x._root;
+				this->_size = x._size;
+				x._allocator = tmpAllocator;
+				x._compare = tmpCompare;
+				x._root = tmpRoot;
+				x._size = tmpSize;
+			}
+			// Clear. Only frees the nodes that no snapshot shares.
+			void						clear()
+			{
+				this->_release(this->_root);
+				this->_root = 0;
+				this->_size = 0;
+			}
+
+			///////////////
+			// OBSERVERS //
+			///////////////
+			// Key comp
+			key_compare		key_comp() const
+			{
+				return this->_compare;
+			}
+
+			////////////////
+			// OPERATIONS //
+			////////////////
+			// Find
+			const_iterator	find(const key_type &k) const
+			{
+				const_iterator	it;
+
+				it = this->lower_bound(k);
+				if (it != this->end() && this->_compare(k, it->first))
+					return this->end();
+				return it;
+			}
+			// Count
+			size_type		count(const key_type &k) const
+			{
+				return (this->_findNode(k) != 0);
+			}
+			// Lower bound. On the way down, the nodes it goes left at are the
+			// ones that come after it, so they make up its path.
+			const_iterator	lower_bound(const key_type &k) const
+			{
+				const_iterator	it;
+				const Node		*node;
+
+				node = this->_root;
+				while (node)
+				{
+					if (this->_compare(node->data.first, k))
+						node = node->right;
+					else
+					{
+						it.push(node);
+						node = node->left;
+					}
+				}
+				return it;
+			}
+			// Upper bound
+			const_iterator	upper_bound(const key_type &k) const
+			{
+				const_iterator	it;
+				const Node		*node;
+
+				node = this->_root;
+				while (node)
+				{
+					if (this->_compare(k, node->data.first))
+					{
+						it.push(node);
+						node = node->left;
+					}
+					else
+						node = node->right;
+				}
+				return it;
+			}
+			// Equal range
+			ft::pair<const_iterator, const_iterator>	equal_range(const key_type &k) const
+			{
+				const_iterator	first;
+				const_iterator	last;
+
+				first = this->lower_bound(k);
+				last = first;
+				if (last != this->end() && !this->_compare(k, last->first))
+					last++;
+				return ft::pair<const_iterator, const_iterator>(first, last);
+			}
+
+			///////////////
+			// ALLOCATOR //
+			///////////////
+			allocator_type		get_allocator() const
+			{
+				return this->_allocator;
+			}
+
+		///////////////////////
+		// PRIVATE VARIABLES //
+		///////////////////////
+		private:
+			NodeAlloc		_allocator;		// The internal allocator.
+			key_compare		_compare;		// The function object that compares keys.
+			Node			*_root;			// A pointer to the root of the tree.
+			size_type		_size;			// The amount of elements in the map.
+
+		//////////////////////////////
+		// PRIVATE MEMBER FUNCTIONS //
+		//////////////////////////////
+		// Every pointer to a node holds one of its refs. The functions that take
+		// a subtree and return one hand the ref over: the subtree that comes in
+		// is no longer the caller's, the one that comes out is.
+		private:
+			// This function adds a ref to a node.
+			void			_retain(Node *node)
+			{
+				if (node)
+					ft::atomic_fetch_add(&node->refs, static_cast<std::size_t>(1),
+						ft::memory_order_relaxed);
+			}
+			// This function lets go of a ref to a node. The last one to let go
+			// frees the node, and lets go of its children. That only goes as
+			// deep as the tree is high.
+			void			_release(Node *node)
+			{
+				if (node == 0)
+					return ;
+				if (ft::atomic_fetch_add(&node->refs, static_cast<std::size_t>(-1),
+						ft::memory_order_acq_rel) != 1)
+					return ;
+				this->_release(node->left);
+				this->_release(node->right);
+				this->_freeNode(node);
+			}
+			// This function returns a node that only this map points to, with
+			// the same element and children as node. That is node itself if
+			// no one else has a ref to it, or a copy that shares its children.
+			Node			*_unique(Node *node)
+			{
+				Node		*copy;
+
+				if (ft::atomic_load(&node->refs, ft::memory_order_acquire) == 1)
+					return node;
+				copy = this->_createNode(node->data);
+				copy->left = node->left;
+				copy->right = node->right;
+				copy->height = node->height;
+				this->_retain(copy->left);
+				this->_retain(copy->right);
+				this->_release(node);
+				return copy;
+			}
+			// This function will create a new node with a copy of val.
+			Node			*_createNode(const value_type &val)
+			{
+				Node		*node;
+
+				node = this->_allocator.allocate(1);
+				this->_allocator.construct(node, val);
+				return node;
+			}
+			// This function frees a single node, without looking at its children.
+			void			_freeNode(Node *node)
+			{
+				this->_allocator.destroy(node);
+				this->_allocator.deallocate(node, 1);
+			}
+			// This function finds the node with key k, or returns 0.
+			const Node		*_findNode(const key_type &k) const
+			{
+				const Node	*node;
+
+				node = this->_root;
+				while (node)
+				{
+					if (this->_compare(k, node->data.first))
+						node = node->left;
+					else if (this->_compare(node->data.first, k))
+						node = node->right;
+					else
+						return node;
+				}
+				return 0;
+			}
+			// This function inserts val, unless its key is already in the map,
+			// and returns whether it did. It walks down the tree only once, and
+			// only copies nodes if it inserts.
+			bool			_insertValue(const value_type &val)
+			{
+				Node		*path[iterator::max_depth];
+				int			depth;
+
+				if (this->_findPath(val.first, path, depth) != -1)
+					return false;
+				this->_insertAt(val, path, depth);
+				return true;
+			}
+			// This function walks down from the root looking for k, and puts the
+			// nodes it passes in path, root first. Depth is set to their amount.
+			// Like ft::map, it compares once per level: the last node it went
+			// right at is the highest key that isn't greater than k. It returns
+			// the index of the node with key k in the path, or -1.
+			int				_findPath(const key_type &k, Node **path, int &depth) const
+			{
+				Node		*node;
+				int			notGreater;
+
+				node = this->_root;
+				notGreater = -1;
+				depth = 0;
+				while (node)
+				{
+					path[depth] = node;
+					if (this->_compare(k, node->data.first))
+						node = node->left;
+					else
+					{
+						notGreater = depth;
+						node = node->right;
+					}
+					depth++;
+				}
+				if (notGreater != -1 && this->_compare(path[notGreater]->data.first, k))
+					return -1;
+				return notGreater;
+			}
+			// This function builds an iterator to path[i] out of the path down to
+			// it. The nodes above it where the path goes left come after it, so
+			// they are on the stack of the iterator too, like in lower_bound.
+			const_iterator	_iteratorAt(Node **path, int i) const
+			{
+				const_iterator	it;
+
+				for (int j = 0; j < i; j++)
+				{
+					if (path[j]->left == path[j + 1])
+						it.push(path[j]);
+				}
+				it.push(path[i]);
+				return it;
+			}
+			// This function hangs node in the place of path[i]: as the root, or
+			// as the child of the node above it.
+			void			_replace(Node **path, int i, Node *node)
+			{
+				if (i == 0)
+					this->_root = node;
+				else if (path[i - 1]->left == path[i])
+					path[i - 1]->left = node;
+				else
+					path[i - 1]->right = node;
+				path[i] = node;
+			}
+			// This function makes the first n nodes of a path unique, so they can
+			// be changed. It has to start at the root: a node with a single ref
+			// is still shared if a node above it is.
+			void			_uniquePath(Node **path, int n)
+			{
+				for (int i = 0; i < n; i++)
+					this->_replace(path, i, this->_unique(path[i]));
+			}
+			// This function hangs a new node with val below the last node of a
+			// path that ends where its key belongs, and adds it to the path. It
+			// returns false if the tree rotated, since the path may not lead to
+			// the node any more then.
+			bool			_insertAt(const value_type &val, Node **path, int depth)
+			{
+				Node		*node;
+
+				this->_uniquePath(path, depth);
+				node = this->_createNode(val);
+				if (depth == 0)
+					this->_root = node;
+				else if (this->_compare(val.first, path[depth - 1]->data.first))
+					path[depth - 1]->left = node;
+				else
+					path[depth - 1]->right = node;
+				path[depth] = node;
+				this->_size++;
+				return !this->_rebalancePath(path, depth - 1);
+			}
+			// This function takes the last node of a path out of the tree. A node
+			// with two children is taken over by the lowest node on its right,
+			// which moves up into its place. Its key can't be copied into the
+			// node instead, since it is const.
+			void			_removeAt(Node **path, int depth)
+			{
+				Node		*node;
+				Node		*next;
+				int			index;
+
+				index = depth - 1;
+				this->_uniquePath(path, depth);
+				node = path[index];
+				if (node->left && node->right)
+				{
+					next = node->right;
+					while (next)
+					{
+						path[depth] = next;
+						this->_replace(path, depth, this->_unique(next));
+						next = path[depth]->left;
+						depth++;
+					}
+					next = path[depth - 1];
+					this->_replace(path, depth - 1, next->right);
+					next->left = node->left;
+					next->right = node->right;
+					next->height = node->height;
+					this->_replace(path, index, next);
+					depth--;
+				}
+				else
+				{
+					this->_replace(path, index, (node->left) ? node->left : node->right);
+					depth = index;
+				}
+				this->_freeNode(node);
+				this->_size--;
+				this->_rebalancePath(path, depth - 1);
+			}
+			// This function walks back up a path from path[i], updating heights
+			// and rotating where necessary. Once a subtree is back at its old
+			// height, nothing above it changes, like in ft::map. The nodes on
+			// the path are unique already, so a node only changes if it rotates.
+			// It returns whether anything rotated.
+			bool			_rebalancePath(Node **path, int i)
+			{
+				Node		*node;
+				int			oldHeight;
+				bool		rotated;
+
+				rotated = false;
+				while (i >= 0)
+				{
+					oldHeight = path[i]->height;
+					node = this->_balance(path[i]);
+					rotated = rotated || (node != path[i]);
+					this->_replace(path, i, node);
+					if (node->height == oldHeight)
+						return rotated;
+					i--;
+				}
+				return rotated;
+			}
+			// This function updates the height of node, whose children just
+			// changed, and rotates it back into balance.
+			Node			*_balance(Node *node)
+			{
+				int			balance;
+
+				node->updateHeight();
+				balance = node->getBalance();
+				if (balance > 1)
+				{
+					// Left right case first needs a rotation of the left child.
+					if (node->left->getBalance() < 0)
+						node->left = this->_leftRotate(node->left);
+					return this->_rightRotate(node);
+				}
+				if (balance < -1)
+				{
+					// Right left case first needs a rotation of the right child.
+					if (node->right->getBalance() > 0)
+						node->right = this->_rightRotate(node->right);
+					return this->_leftRotate(node);
+				}
+				return node;
+			}
+			// This function rotates node to the left, and returns the node that
+			// takes its place. Both nodes change, so both are made unique: after
+			// an erase, the other side of the tree may still be shared.
+			Node			*_leftRotate(Node *node)
+			{
+				Node		*pivot;
+
+				node = this->_unique(node);
+				pivot = this->_unique(node->right);
+				node->right = pivot->left;
+				pivot->left = node;
+				node->updateHeight();
+				pivot->updateHeight();
+				return pivot;
+			}
+			// This function rotates node to the right, and returns the node that
+			// takes its place.
+			Node			*_rightRotate(Node *node)
+			{
+				Node		*pivot;
+
+				node = this->_unique(node);
+				pivot = this->_unique(node->left);
+				node->left = pivot->right;
+				pivot->right = node;
+				node->updateHeight();
+				pivot->updateHeight();
+				return pivot;
+			}
+	};
+
+	//////////////////////////
+	// RELATIONAL OPERATORS //
+	//////////////////////////
+	// == operator
+	template <class Key, class T, class Compare, class Alloc>
+	bool		operator==(const persistent_map<Key, T, Compare, Alloc> &lhs,
+							const persistent_map<Key, T, Compare, Alloc> &rhs)
+	{
+		typename persistent_map<Key, T, Compare, Alloc>::const_iterator	lhsit, rhsit;
+
+		if (lhs.size() != rhs.size())
+			return false;
+		lhsit = lhs.begin();
+		rhsit = rhs.begin();
+		while (lhsit != lhs.end())
+		{
+			if ((lhsit->first != rhsit->first) || (lhsit->second != rhsit->second))
+				return false;
+			lhsit++;
+			rhsit++;
+		}
+		return true;
+	}
+	// != operator
+	template <class Key, class T, class Compare, class Alloc>
+	bool		operator!=(const persistent_map<Key, T, Compare, Alloc> &lhs,
+							const persistent_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return !(lhs == rhs);
+	}
+	// Swap
+	template <class Key, class T, class Compare, class Alloc>
+	void		swap(persistent_map<Key, T, Compare, Alloc> &lhs,
+					persistent_map<Key, T, Compare, Alloc> &rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
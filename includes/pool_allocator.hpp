@@ -0,0 +1,291 @@
+#ifndef POOL_ALLOCATOR_HPP
+# define POOL_ALLOCATOR_HPP
+
+# include <cstddef>				// size_t, ptrdiff_t
+# include <new>					// operator new, placement new
+# include "is_same.hpp"			// is_same
+
+namespace ft
+{
+	// An allocator for node based containers. Single objects are handed out
+	// from fixed-size slabs, and are recycled through a free list when they
+	// are deallocated. The slabs themselves are only released when the last
+	// allocator sharing the pool is destroyed. Requests for more than one
+	// object go straight to operator new.
+	// All allocators of the same type share one pool, so memory from one can
+	// be freed by any other, like the containers expect: a list can splice
+	// nodes from another list, and destroy them later. The pool is not thread
+	// safe, so containers with the same pool allocator type can't be used
+	// from different threads at once.
+	template <class T, std::size_t BlocksPerSlab = 256>
+	class pool_allocator
+	{
+		//////////////////
+		// MEMBER TYPES //
+		//////////////////
+		public:
+			typedef T					value_type;
+			typedef T*					pointer;
+			typedef const T*			const_pointer;
+			typedef T&					reference;
+			typedef const T&			const_reference;
+			typedef std::size_t			size_type;
+			typedef std::ptrdiff_t		difference_type;
+
+			template <class U>
+			struct rebind
+			{
+				typedef pool_allocator<U, BlocksPerSlab>	other;
+			};
+
+		///////////////////
+		// PRIVATE TYPES //
+		///////////////////
+		private:
+			// A free block stores the link to the next free block in itself.
+			struct Block
+			{
+				Block		*next;
+			};
+			// Every slab starts with a link to the previously allocated slab.
+			struct Slab
+			{
+				Slab		*next;
+			};
+			// The state that is shared by all allocators of the same type.
+			struct Pool
+			{
+				Block		*freeList;	// Blocks that were deallocated.
+				char		*current;	// The next untouched block in the newest slab.
+				char		*end;		// The end of the newest slab.
+				Slab		*slabs;		// All slabs, newest first.
+				size_type	refs;		// The amount of allocators using this pool.
+			};
+			// Used to find the alignment of T, without C++11's alignof.
+			struct AlignOf
+			{
+				char		c;
+				T			t;
+			};
+
+		//////////////////////
+		// MEMBER FUNCTIONS //
+		//////////////////////
+		public:
+			//////////////////
+			// CONSTRUCTORS //
+			//////////////////
+			// Default constructor
+			pool_allocator()
+			{
+				_shared.refs++;
+			}
+			// Copy constructor
+			pool_allocator(const pool_allocator &)
+			{
+				_shared.refs++;
+			}
+			// Rebind constructor. Joins the pool of its own type.
+			template <class U>
+			pool_allocator(const pool_allocator<U, BlocksPerSlab> &)
+			{
+				_shared.refs++;
+			}
+			////////////////
+			// DESTRUCTOR //
+			////////////////
+			~pool_allocator()
+			{
+				this->_release();
+			}
+
+			/////////////////////////
+			// ASSIGNMENT OVERLOAD //
+			/////////////////////////
+			// Both already share the same pool.
+			pool_allocator		&operator=(const pool_allocator &)
+			{
+				return *this;
+			}
+
+			/////////////
+			// ADDRESS //
+			/////////////
+			// Address
+			pointer			address(reference x) const
+			{
+				return &x;
+			}
+			// Address (const)
+			const_pointer	address(const_reference x) const
+			{
+				return &x;
+			}
+
+			////////////////
+			// ALLOCATION //
+			////////////////
+			// Allocate
+			pointer			allocate(size_type n, const void * = 0)
+			{
+				Block		*block;
+
+				if (n != 1)
+					return static_cast<pointer>(::operator new(n * sizeof(T)));
+				if (_shared.freeList)
+				{
+					block = _shared.freeList;
+					_shared.freeList = block->next;
+					return reinterpret_cast<pointer>(block);
+				}
+				if (_shared.current == _shared.end)
+					this->_addSlab();
+				block = reinterpret_cast<Block *>(_shared.current);
+				_shared.current += _blockSize();
+				return reinterpret_cast<pointer>(block);
+			}
+			// Deallocate
+			void			deallocate(pointer p, size_type n)
+			{
+				Block		*block;
+
+				if (n != 1)
+				{
+					::operator delete(p);
+					return ;
+				}
+				block = reinterpret_cast<Block *>(p);
+				block->next = _shared.freeList;
+				_shared.freeList = block;
+			}
+			// Release all. If no other allocator of this type exists, this frees
+			// all slabs at once, which deallocates every block without
+			// destroying what is in it. If the pool is shared, it does nothing
+			// and returns false.
+			bool			release_all()
+			{
+				if (_shared.refs != 1)
+					return false;
+				this->_freeSlabs();
+				return true;
+			}
+			// Max size
+			size_type		max_size() const
+			{
+				return static_cast<size_type>(-1) / sizeof(T);
+			}
+
+			//////////////////
+			// CONSTRUCTION //
+			//////////////////
+			// Construct
+			void			construct(pointer p, const_reference val)
+			{
+				new (static_cast<void *>(p)) T(val);
+			}
+			// Destroy
+			void			destroy(pointer p)
+			{
+				p->~T();
+			}
+
+		///////////////////////
+		// PRIVATE VARIABLES //
+		///////////////////////
+		private:
+			static Pool		_shared;	// The pool of every allocator of this type.
+
+		//////////////////////////////
+		// PRIVATE MEMBER FUNCTIONS //
+		//////////////////////////////
+		private:
+			// The alignment that every block needs.
+			static size_type	_alignment()
+			{
+				size_type	align;
+
+				align = sizeof(AlignOf) - sizeof(T);
+				if (align < sizeof(Block))
+					align = sizeof(Block);
+				return align;
+			}
+			// The size of a single block, big enough for a T or a free list link,
+			// rounded up so the next block is aligned as well.
+			static size_type	_blockSize()
+			{
+				size_type	size;
+
+				size = (sizeof(T) < sizeof(Block)) ? sizeof(Block) : sizeof(T);
+				return (size + _alignment() - 1) / _alignment() * _alignment();
+			}
+			// The space at the start of a slab that is taken up by its header.
+			static size_type	_headerSize()
+			{
+				return (sizeof(Slab) + _alignment() - 1) / _alignment() * _alignment();
+			}
+			// This function allocates a new slab, and makes it the one that fresh
+			// blocks are taken from.
+			void				_addSlab()
+			{
+				Slab		*slab;
+				char		*memory;
+
+				memory = static_cast<char *>(::operator new(_headerSize() + _blockSize() * BlocksPerSlab));
+				slab = reinterpret_cast<Slab *>(memory);
+				slab->next = _shared.slabs;
+				_shared.slabs = slab;
+				_shared.current = memory + _headerSize();
+				_shared.end = _shared.current + _blockSize() * BlocksPerSlab;
+			}
+			// This function frees all slabs, and leaves the pool empty.
+			void				_freeSlabs()
+			{
+				Slab		*slab;
+				Slab		*next;
+
+				slab = _shared.slabs;
+				while (slab)
+				{
+					next = slab->next;
+					::operator delete(slab);
+					slab = next;
+				}
+				_shared.freeList = 0;
+				_shared.current = 0;
+				_shared.end = 0;
+				_shared.slabs = 0;
+			}
+			// This function lets go of the pool. The last allocator to do so
+			// releases all slabs at once.
+			void				_release()
+			{
+				_shared.refs--;
+				if (_shared.refs == 0)
+					this->_freeSlabs();
+			}
+
+	};
+
+	// The pool starts out empty. It holds no objects, so it is set up before
+	// any constructor of a static container could use it.
+	template <class T, std::size_t BlocksPerSlab>
+	typename pool_allocator<T, BlocksPerSlab>::Pool	pool_allocator<T, BlocksPerSlab>::_shared = { 0, 0, 0, 0, 0 };
+
+	//////////////////////////
+	// RELATIONAL OPERATORS //
+	//////////////////////////
+	// Two allocators are equal if memory from one can be freed by the other,
+	// which is the case if they are of the same type.
+	template <class T1, class T2, std::size_t N>
+	bool	operator==(const pool_allocator<T1, N> &, const pool_allocator<T2, N> &)
+	{
+		return ft::is_same<T1, T2>::value;
+	}
+	template <class T1, class T2, std::size_t N>
+	bool	operator!=(const pool_allocator<T1, N> &lhs, const pool_allocator<T2, N> &rhs)
+	{
+		return !(lhs == rhs);
+	}
+}
+
+#endif
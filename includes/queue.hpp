@@ -1,11 +1,11 @@
 #ifndef QUEUE_HPP
 # define QUEUE_HPP
 
-# include <deque>			// deque is the default container
+# include "deque.hpp"		// deque is the default container
 
 namespace ft
 {
-	template <class T, class Container = std::deque<T> >
+	template <class T, class Container = ft::deque<T> >
 	class queue
 	{
 		//////////////////
@@ -50,6 +50,7 @@ namespace ft
 			queue			&operator=(const queue &other)
 			{
 				this->c = other.c;
+				return *this;
 			}
 
 			//////////////
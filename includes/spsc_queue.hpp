@@ -0,0 +1,190 @@
+#ifndef SPSC_QUEUE_HPP
+# define SPSC_QUEUE_HPP
+
+# include <cstddef>				// size_t
+# include <memory>				// allocator
+# include "atomic.hpp"			// atomic loads and stores, cache_line_size
+
+namespace ft
+{
+	// A bounded queue for exactly one producer thread and one consumer thread,
+	// which never takes a lock. The elements are kept in a ring buffer of N
+	// slots. The producer only writes the tail index and the consumer only
+	// writes the head index, and both are on their own cache line.
+	// Each side also keeps a copy of the other side's index, and only reads the
+	// real index again once its copy says the queue is full or empty. That
+	// way, the cache lines only move between the cores when they have to.
+	template <class T, std::size_t N>
+	class spsc_queue
+	{
+		//////////////////
+		// MEMBER TYPES //
+		//////////////////
+		public:
+			typedef T					value_type;
+			typedef std::size_t			size_type;
+			typedef T&					reference;
+			typedef const T&			const_reference;
+
+		//////////////////////
+		// MEMBER FUNCTIONS //
+		//////////////////////
+		public:
+			//////////////////
+			// CONSTRUCTORS //
+			//////////////////
+			// Default constructor
+			spsc_queue() : _head(0), _cachedTail(0), _tail(0), _cachedHead(0)
+			{
+				this->_buffer = this->_allocator.allocate(N);
+			}
+			////////////////
+			// DESTRUCTOR //
+			////////////////
+			~spsc_queue()
+			{
+				for (size_type i = this->_head; i != this->_tail; i++)
+					this->_allocator.destroy(&this->_buffer[i % N]);
+				this->_allocator.deallocate(this->_buffer, N);
+			}
+
+			//////////////
+			// CAPACITY //
+			//////////////
+			// Empty. Only exact when both threads are idle.
+			bool		empty() const
+			{
+				return (this->size() == 0);
+			}
+			// Size. Only exact when both threads are idle.
+			size_type	size() const
+			{
+				size_type	head = ft::atomic_load(&this->_head, ft::memory_order_acquire);
+				size_type	tail = ft::atomic_load(&this->_tail, ft::memory_order_acquire);
+
+				return tail - head;
+			}
+			// Capacity
+			size_type	capacity() const
+			{
+				return N;
+			}
+
+			///////////////////
+			// PRODUCER SIDE //
+			///////////////////
+			// Try push. Returns false if the queue is full.
+			bool		try_push(const value_type &val)
+			{
+				size_type	tail = ft::atomic_load(&this->_tail, ft::memory_order_relaxed);
+
+				if (tail - this->_cachedHead == N)
+				{
+					this->_cachedHead = ft::atomic_load(&this->_head, ft::memory_order_acquire);
+					if (tail - this->_cachedHead == N)
+						return false;
+				}
+				this->_allocator.construct(&this->_buffer[tail % N], val);
+				ft::atomic_store(&this->_tail, tail + 1, ft::memory_order_release);
+				return true;
+			}
+			// Push n. Pushes as many of the n values as there is room for, and
+			// publishes them all at once. Returns the amount that was pushed.
+			size_type	push_n(const value_type *values, size_type n)
+			{
+				size_type	tail = ft::atomic_load(&this->_tail, ft::memory_order_relaxed);
+
+				if (N - (tail - this->_cachedHead) < n)
+					this->_cachedHead = ft::atomic_load(&this->_head, ft::memory_order_acquire);
+				if (N - (tail - this->_cachedHead) < n)
+					n = N - (tail - this->_cachedHead);
+				for (size_type i = 0; i < n; i++)
+					this->_allocator.construct(&this->_buffer[(tail + i) % N], values[i]);
+				if (n != 0)
+					ft::atomic_store(&this->_tail, tail + n, ft::memory_order_release);
+				return n;
+			}
+
+			///////////////////
+			// CONSUMER SIDE //
+			///////////////////
+			// Front. Returns the oldest element, or a null pointer if the queue
+			// is empty. The element stays valid until it is popped.
+			value_type	*front()
+			{
+				size_type	head = ft::atomic_load(&this->_head, ft::memory_order_relaxed);
+
+				if (head == this->_cachedTail)
+				{
+					this->_cachedTail = ft::atomic_load(&this->_tail, ft::memory_order_acquire);
+					if (head == this->_cachedTail)
+						return 0;
+				}
+				return &this->_buffer[head % N];
+			}
+			// Try pop. Moves the oldest element into val. Returns false if the
+			// queue is empty.
+			bool		try_pop(value_type &val)
+			{
+				value_type	*elem = this->front();
+
+				if (elem == 0)
+					return false;
+				val = *elem;
+				this->pop();
+				return true;
+			}
+			// Pop. Removes the oldest element, the queue must not be empty.
+			void		pop()
+			{
+				size_type	head = ft::atomic_load(&this->_head, ft::memory_order_relaxed);
+
+				this->_allocator.destroy(&this->_buffer[head % N]);
+				ft::atomic_store(&this->_head, head + 1, ft::memory_order_release);
+			}
+			// Pop n. Moves up to n of the oldest elements into values, and frees
+			// their slots all at once. Returns the amount that was popped.
+			size_type	pop_n(value_type *values, size_type n)
+			{
+				size_type	head = ft::atomic_load(&this->_head, ft::memory_order_relaxed);
+
+				if (this->_cachedTail - head < n)
+					this->_cachedTail = ft::atomic_load(&this->_tail, ft::memory_order_acquire);
+				if (this->_cachedTail - head < n)
+					n = this->_cachedTail - head;
+				for (size_type i = 0; i < n; i++)
+				{
+					values[i] = this->_buffer[(head + i) % N];
+					this->_allocator.destroy(&this->_buffer[(head + i) % N]);
+				}
+				if (n != 0)
+					ft::atomic_store(&this->_head, head + n, ft::memory_order_release);
+				return n;
+			}
+
+		///////////////////////
+		// PRIVATE VARIABLES //
+		///////////////////////
+		private:
+			// Keeps the indices off the cache line of whatever is in front of
+			// the queue in memory.
+			char					_padFront[ft::cache_line_size];
+			// Written by the consumer.
+			size_type				_head;
+			size_type				_cachedTail;
+			char					_padHead[ft::cache_line_size - 2 * sizeof(size_type)];
+			// Written by the producer.
+			size_type				_tail;
+			size_type				_cachedHead;
+			char					_padTail[ft::cache_line_size - 2 * sizeof(size_type)];
+			// Only read after construction.
+			std::allocator<T>		_allocator;
+			T						*_buffer;
+
+			// A queue can't be copied while other threads are using it.
+			spsc_queue(const spsc_queue &);
+			spsc_queue	&operator=(const spsc_queue &);
+	};
+}
+
+#endif
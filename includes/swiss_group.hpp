@@ -0,0 +1,207 @@
+#ifndef SWISS_GROUP_HPP
+# define SWISS_GROUP_HPP
+
+# include <cstddef>				// size_t
+# include <cstring>				// memcpy
+# include <stdint.h>			// uint32_t, uint64_t
+
+// The widest instruction set that the compiler may use picks the group. Define
+// FT_SWISS_NO_SIMD to use the portable version everywhere.
+# if !defined(FT_SWISS_NO_SIMD) && defined(__AVX2__)
+#  define FT_SWISS_AVX2 1
+#  include <immintrin.h>		// AVX2 intrinsics
+# elif !defined(FT_SWISS_NO_SIMD) && defined(__SSE2__)
+#  define FT_SWISS_SSE2 1
+#  include <emmintrin.h>		// SSE2 intrinsics
+# endif
+
+namespace ft
+{
+	// The control bytes of a swiss table. A used slot has the low 7 bits of
+	// the hash of its key, so its high bit is clear. The other values all
+	// have the high bit set.
+	static const unsigned char	swiss_empty = 0x80;
+	static const unsigned char	swiss_deleted = 0xFE;
+	static const unsigned char	swiss_sentinel = 0xFF;
+
+	// A set of positions in a group, one bit for each. With SIMD there is one
+	// bit per byte, and the portable version uses the high bit of every byte,
+	// so Shift turns a bit number into a position.
+	template <class T, int Shift>
+	class swiss_bitmask
+	{
+		public:
+			// Parameterized constructor
+			explicit swiss_bitmask(T mask) : _mask(mask)
+			{
+			}
+			// Any. True if there is a position left.
+			bool			any() const
+			{
+				return (this->_mask != 0);
+			}
+			// Lowest. The lowest position left.
+			std::size_t		lowest() const
+			{
+				if (sizeof(T) > sizeof(unsigned int))
+					return static_cast<std::size_t>(__builtin_ctzll(this->_mask)) >> Shift;
+				return static_cast<std::size_t>(__builtin_ctz(this->_mask)) >> Shift;
+			}
+			// Leading zeros. The amount of positions above the highest one.
+			std::size_t		leading_zeros(std::size_t width) const
+			{
+				std::size_t		bits = 8 * sizeof(T);
+				std::size_t		zeros;
+
+				if (sizeof(T) > sizeof(unsigned int))
+					zeros = __builtin_clzll(this->_mask);
+				else
+					zeros = __builtin_clz(this->_mask) - (8 * sizeof(unsigned int) - bits);
+				return (zeros - (bits - (width << Shift))) >> Shift;
+			}
+			// Clear lowest. Removes the lowest position.
+			void			clear_lowest()
+			{
+				this->_mask &= this->_mask - 1;
+			}
+
+		private:
+			T		_mask;
+	};
+
+#if defined(FT_SWISS_AVX2)
+	// A group of 32 control bytes, compared with AVX2.
+	class swiss_group
+	{
+		public:
+			typedef swiss_bitmask<uint32_t, 0>	bitmask;
+			static const std::size_t			width = 32;
+
+			// Parameterized constructor. Loads the bytes from control.
+			explicit swiss_group(const unsigned char *control)
+				: _control(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(control)))
+			{
+			}
+			// Match. The positions that have this hash.
+			bitmask		match(unsigned char hash) const
+			{
+				__m256i		wanted = _mm256_set1_epi8(static_cast<char>(hash));
+
+				return bitmask(static_cast<uint32_t>(
+					_mm256_movemask_epi8(_mm256_cmpeq_epi8(wanted, this->_control))));
+			}
+			// Match empty
+			bitmask		match_empty() const
+			{
+				return this->match(swiss_empty);
+			}
+			// Match empty or deleted. Those are the bytes below the sentinel,
+			// when they are compared as signed bytes.
+			bitmask		match_empty_or_deleted() const
+			{
+				__m256i		sentinel = _mm256_set1_epi8(static_cast<char>(swiss_sentinel));
+
+				return bitmask(static_cast<uint32_t>(
+					_mm256_movemask_epi8(_mm256_cmpgt_epi8(sentinel, this->_control))));
+			}
+
+		private:
+			__m256i		_control;
+	};
+#elif defined(FT_SWISS_SSE2)
+	// A group of 16 control bytes, compared with SSE2.
+	class swiss_group
+	{
+		public:
+			typedef swiss_bitmask<uint32_t, 0>	bitmask;
+			static const std::size_t			width = 16;
+
+			// Parameterized constructor. Loads the bytes from control.
+			explicit swiss_group(const unsigned char *control)
+				: _control(_mm_loadu_si128(reinterpret_cast<const __m128i *>(control)))
+			{
+			}
+			// Match. The positions that have this hash.
+			bitmask		match(unsigned char hash) const
+			{
+				__m128i		wanted = _mm_set1_epi8(static_cast<char>(hash));
+
+				return bitmask(static_cast<uint32_t>(
+					_mm_movemask_epi8(_mm_cmpeq_epi8(wanted, this->_control))));
+			}
+			// Match empty
+			bitmask		match_empty() const
+			{
+				return this->match(swiss_empty);
+			}
+			// Match empty or deleted. Those are the bytes below the sentinel,
+			// when they are compared as signed bytes.
+			bitmask		match_empty_or_deleted() const
+			{
+				__m128i		sentinel = _mm_set1_epi8(static_cast<char>(swiss_sentinel));
+
+				return bitmask(static_cast<uint32_t>(
+					_mm_movemask_epi8(_mm_cmpgt_epi8(sentinel, this->_control))));
+			}
+
+		private:
+			__m128i		_control;
+	};
+#else
+	// A group of 8 control bytes, compared as one 64 bit word. The result has
+	// the high bit set of every byte that matched.
+	class swiss_group
+	{
+		public:
+			typedef swiss_bitmask<uint64_t, 3>	bitmask;
+			static const std::size_t			width = 8;
+
+			// Parameterized constructor. Loads the bytes from control, with the
+			// first byte in the lowest bits.
+			explicit swiss_group(const unsigned char *control)
+			{
+				std::memcpy(&this->_control, control, sizeof(this->_control));
+# if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+				this->_control = __builtin_bswap64(this->_control);
+# endif
+			}
+			// Match. The positions that have this hash. A byte can match by
+			// mistake when the byte before it matched, so the caller still has
+			// to compare the keys.
+			bitmask		match(unsigned char hash) const
+			{
+				uint64_t	x = this->_control ^ (_lsbs() * hash);
+
+				return bitmask((x - _lsbs()) & ~x & _msbs());
+			}
+			// Match empty. Only an empty byte has the high bit set and bit 1
+			// clear.
+			bitmask		match_empty() const
+			{
+				return bitmask(this->_control & ~(this->_control << 6) & _msbs());
+			}
+			// Match empty or deleted. Only the sentinel has the high bit and
+			// bit 0 set.
+			bitmask		match_empty_or_deleted() const
+			{
+				return bitmask(this->_control & ~(this->_control << 7) & _msbs());
+			}
+
+		private:
+			uint64_t	_control;
+
+			// The lowest bit of every byte.
+			static uint64_t		_lsbs()
+			{
+				return (static_cast<uint64_t>(0x01010101u) << 32) | 0x01010101u;
+			}
+			// The highest bit of every byte.
+			static uint64_t		_msbs()
+			{
+				return (static_cast<uint64_t>(0x80808080u) << 32) | 0x80808080u;
+			}
+	};
+#endif
+}
+
+#endif
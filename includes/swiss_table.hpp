@@ -0,0 +1,558 @@
+#ifndef SWISS_TABLE_HPP
+# define SWISS_TABLE_HPP
+
+# include <cstddef>				// size_t, ptrdiff_t
+# include <cstring>				// memcpy, memset
+# include <memory>				// allocator
+# include <stdint.h>			// uint64_t
+# include "HashIterator.hpp"	// HashIterator class
+# include "pair.hpp"			// pair class
+# include "swiss_group.hpp"		// swiss_group, control bytes
+# include "utils.hpp"			// swap
+
+namespace ft
+{
+	// The hash table behind flat_hash_map and flat_hash_set. It uses open
+	// addressing, and keeps one control byte for every slot: empty, deleted,
+	// or the low 7 bits of the hash of the key in it (see swiss_group.hpp).
+	// A lookup looks at a whole group of control bytes at once, and only
+	// compares the keys of the slots whose byte matches. It goes on to the
+	// next group (the steps between them growing by a group each time) until
+	// a group has an empty byte.
+	// The capacity is always a power of two minus one. After the control byte
+	// of the last slot comes the sentinel, which ends iteration, and then
+	// copies of the first group minus one bytes, so a group can be loaded at
+	// any slot without wrapping around.
+	// Value is the element type, and KeyOfValue gets the key out of one.
+	template <class Value, class Key, class KeyOfValue, class Hash, class Pred, class Alloc>
+	class swiss_table
+	{
+		//////////////////
+		// MEMBER TYPES //
+		//////////////////
+		public:
+			typedef Key														key_type;
+			typedef Value													value_type;
+			typedef Hash													hasher;
+			typedef Pred													key_equal;
+			typedef Alloc													allocator_type;
+			typedef HashIterator<value_type>								iterator;
+			typedef HashIterator<value_type, const value_type*, const value_type&>	const_iterator;
+			typedef std::ptrdiff_t											difference_type;
+			typedef std::size_t												size_type;
+			typedef typename allocator_type::template rebind<unsigned char>::other	ControlAlloc;
+
+		//////////////////////
+		// MEMBER FUNCTIONS //
+		//////////////////////
+		public:
+			//////////////////
+			// CONSTRUCTORS //
+			//////////////////
+			// Default constructor
+			explicit swiss_table(const hasher &hf = hasher(), const key_equal &eql = key_equal(),
+					const allocator_type &alloc = allocator_type())
+				: _allocator(alloc), _controlAllocator(alloc), _hash(hf), _equal(eql),
+					_slots(0), _control(_emptyControl()), _capacity(0), _size(0),
+					_growthLeft(0), _maxLoadFactor(_defaultMaxLoadFactor)
+			{
+			}
+			// Copy constructor
+			swiss_table(const swiss_table &x)
+				: _allocator(x._allocator), _controlAllocator(x._controlAllocator),
+					_hash(x._hash), _equal(x._equal), _slots(0), _control(_emptyControl()),
+					_capacity(0), _size(0), _growthLeft(0), _maxLoadFactor(x._maxLoadFactor)
+			{
+				this->_copyTable(x);
+			}
+			////////////////
+			// DESTRUCTOR //
+			////////////////
+			~swiss_table()
+			{
+				this->_destroyTable();
+			}
+
+			/////////////////////////
+			// ASSIGNMENT OVERLOAD //
+			/////////////////////////
+			swiss_table		&operator=(const swiss_table &x)
+			{
+				if (this == &x)
+					return *this;
+				this->_destroyTable();
+				this->_hash = x._hash;
+				this->_equal = x._equal;
+				this->_maxLoadFactor = x._maxLoadFactor;
+				this->_copyTable(x);
+				return *this;
+			}
+
+			///////////////
+			// ITERATORS //
+			///////////////
+			// Begin
+			iterator		begin()
+			{
+				return iterator(this->_slots, this->_control);
+			}
+			// Begin (const)
+			const_iterator	begin() const
+			{
+				return const_iterator(this->_slots, this->_control);
+			}
+			// End
+			iterator		end()
+			{
+				return this->_iteratorAt(this->_capacity);
+			}
+			// End (const)
+			const_iterator	end() const
+			{
+				return const_iterator(this->_slots + this->_capacity,
+						this->_control + this->_capacity);
+			}
+
+			//////////////
+			// CAPACITY //
+			//////////////
+			// Empty
+			bool		empty() const
+			{
+				return (this->_size == 0);
+			}
+			// Size
+			size_type	size() const
+			{
+				return this->_size;
+			}
+			// Max size
+			size_type	max_size() const
+			{
+				return this->_allocator.max_size();
+			}
+
+			///////////////
+			// MODIFIERS //
+			///////////////
+			// Insert. Adds val if there is no element with its key yet.
+			ft::pair<iterator, bool>	insert(const value_type &val)
+			{
+				uint64_t	hash = this->_hashOf(this->_keyOf(val));
+				size_type	index;
+
+				index = this->_findIndex(this->_keyOf(val), hash);
+				if (index != this->_capacity)
+					return ft::pair<iterator, bool>(this->_iteratorAt(index), false);
+				index = this->_prepareInsert(hash);
+				this->_allocator.construct(&this->_slots[index], val);
+				this->_setControl(index, _h2(hash));
+				this->_size++;
+				return ft::pair<iterator, bool>(this->_iteratorAt(index), true);
+			}
+			// Erase (By iterator)
+			void		erase(const_iterator position)
+			{
+				size_type	index;
+
+				index = position.slot() - this->_slots;
+				this->_allocator.destroy(&this->_slots[index]);
+				this->_eraseControl(index);
+			}
+			// Erase (By key)
+			template <class K>
+			size_type	erase_key(const K &k)
+			{
+				size_type	index;
+
+				index = this->_findIndex(k, this->_hashOf(k));
+				if (index == this->_capacity)
+					return 0;
+				this->_allocator.destroy(&this->_slots[index]);
+				this->_eraseControl(index);
+				return 1;
+			}
+			// Swap
+			void		swap(swiss_table &x)
+			{
+				ft::swap(this->_allocator, x._allocator);
+				ft::swap(this->_controlAllocator, x._controlAllocator);
+				ft::swap(this->_hash, x._hash);
+				ft::swap(this->_equal, x._equal);
+				ft::swap(this->_slots, x._slots);
+				ft::swap(this->_control, x._control);
+				ft::swap(this->_capacity, x._capacity);
+				ft::swap(this->_size, x._size);
+				ft::swap(this->_growthLeft, x._growthLeft);
+				ft::swap(this->_maxLoadFactor, x._maxLoadFactor);
+			}
+			// Clear. Keeps the slots.
+			void		clear()
+			{
+				if (this->_capacity == 0)
+					return ;
+				for (size_type i = 0; i < this->_capacity; i++)
+					if (this->_control[i] < swiss_empty)
+						this->_allocator.destroy(&this->_slots[i]);
+				this->_resetControl();
+				this->_size = 0;
+			}
+
+			////////////////
+			// OPERATIONS //
+			////////////////
+			// Find
+			template <class K>
+			iterator		find(const K &k)
+			{
+				return this->_iteratorAt(this->_findIndex(k, this->_hashOf(k)));
+			}
+			// Find (const)
+			template <class K>
+			const_iterator	find(const K &k) const
+			{
+				size_type	index;
+
+				index = this->_findIndex(k, this->_hashOf(k));
+				return const_iterator(this->_slots + index, this->_control + index);
+			}
+			// Count
+			template <class K>
+			size_type		count(const K &k) const
+			{
+				return (this->_findIndex(k, this->_hashOf(k)) != this->_capacity);
+			}
+
+			/////////////////
+			// HASH POLICY //
+			/////////////////
+			// Bucket count. Every slot is a bucket of one.
+			size_type		bucket_count() const
+			{
+				return this->_capacity;
+			}
+			// Load factor
+			float			load_factor() const
+			{
+				if (this->_capacity == 0)
+					return 0;
+				return static_cast<float>(this->_size) / this->_capacity;
+			}
+			// Max load factor
+			float			max_load_factor() const
+			{
+				return this->_maxLoadFactor;
+			}
+			// Max load factor (Set). It has to be between 0.1 and 0.875, so
+			// every probe finds an empty byte soon enough.
+			void			max_load_factor(float z)
+			{
+				if (z < 0.1f)
+					z = 0.1f;
+				if (z > _defaultMaxLoadFactor)
+					z = _defaultMaxLoadFactor;
+				this->_maxLoadFactor = z;
+				if (this->_capacity != 0)
+					this->rehash(0);
+			}
+			// Rehash. Makes the table at least n slots big, and big enough for
+			// its elements. This also clears the deleted bytes.
+			void			rehash(size_type n)
+			{
+				size_type	capacity;
+
+				capacity = _minCapacity();
+				while (capacity < n || this->_growthCapacity(capacity) < this->_size)
+					capacity = capacity * 2 + 1;
+				this->_resize(capacity);
+			}
+			// Reserve. Makes room for n elements without growing. If the table
+			// is big enough but deleted slots took up the room, it is rebuilt at
+			// the same size.
+			void			reserve(size_type n)
+			{
+				size_type	capacity;
+
+				capacity = _minCapacity();
+				while (this->_growthCapacity(capacity) < n)
+					capacity = capacity * 2 + 1;
+				if (capacity > this->_capacity)
+					this->_resize(capacity);
+				else if (n > this->_size && this->_growthLeft < n - this->_size)
+					this->_resize(this->_capacity);
+			}
+
+			///////////////
+			// OBSERVERS //
+			///////////////
+			// Hash function
+			hasher			hash_function() const
+			{
+				return this->_hash;
+			}
+			// Key eq
+			key_equal		key_eq() const
+			{
+				return this->_equal;
+			}
+
+			///////////////
+			// ALLOCATOR //
+			///////////////
+			allocator_type	get_allocator() const
+			{
+				return this->_allocator;
+			}
+
+		///////////////////////
+		// PRIVATE VARIABLES //
+		///////////////////////
+		private:
+			static const float			_defaultMaxLoadFactor;
+
+			allocator_type		_allocator;
+			ControlAlloc		_controlAllocator;
+			hasher				_hash;
+			key_equal			_equal;
+			KeyOfValue			_keyOf;
+			value_type			*_slots;
+			unsigned char		*_control;
+			// A power of two minus one, so it is also the mask for slot numbers.
+			size_type			_capacity;
+			size_type			_size;
+			// The amount of empty slots that can still be used before the table
+			// has to grow. Reusing a deleted slot doesn't count.
+			size_type			_growthLeft;
+			float				_maxLoadFactor;
+
+		//////////////////////////////
+		// PRIVATE MEMBER FUNCTIONS //
+		//////////////////////////////
+		private:
+			// The control bytes of a table without slots: only the sentinel.
+			static unsigned char	*_emptyControl()
+			{
+				static unsigned char	control = swiss_sentinel;
+
+				return &control;
+			}
+			// The smallest capacity. The copied bytes at the end have to fit in
+			// the table.
+			static size_type		_minCapacity()
+			{
+				size_type	capacity = 1;
+
+				while (capacity < swiss_group::width - 1)
+					capacity = capacity * 2 + 1;
+				return capacity;
+			}
+			// The first and second hash. H1 picks the group to start at, and the
+			// low 7 bits (H2) go into the control byte.
+			static size_type		_h1(uint64_t hash)
+			{
+				return static_cast<size_type>(hash >> 7);
+			}
+			static unsigned char	_h2(uint64_t hash)
+			{
+				return static_cast<unsigned char>(hash & 0x7F);
+			}
+			// This function returns the hash of a key, with the bits mixed, since
+			// the hash of an integer is the integer itself.
+			template <class K>
+			uint64_t		_hashOf(const K &k) const
+			{
+				uint64_t	golden = (static_cast<uint64_t>(0x9E3779B9u) << 32) | 0x7F4A7C15u;
+				uint64_t	hash = static_cast<uint64_t>(this->_hash(k)) * golden;
+
+				return hash ^ (hash >> 32);
+			}
+			// The amount of elements the table holds before it grows.
+			size_type		_growthCapacity(size_type capacity) const
+			{
+				size_type	growth = static_cast<size_type>(capacity * this->_maxLoadFactor);
+
+				return (growth < capacity) ? growth : capacity - 1;
+			}
+			// This function returns an iterator to a slot.
+			iterator		_iteratorAt(size_type index)
+			{
+				return iterator(this->_slots + index, this->_control + index);
+			}
+			// This function returns the slot of k, or the capacity if k isn't in
+			// the table.
+			template <class K>
+			size_type		_findIndex(const K &k, uint64_t hash) const
+			{
+				size_type	pos;
+				size_type	step;
+				size_type	index;
+
+				if (this->_size == 0)
+					return this->_capacity;
+				pos = _h1(hash) & this->_capacity;
+				step = 0;
+				while (true)
+				{
+					swiss_group		group(this->_control + pos);
+
+					for (typename swiss_group::bitmask match = group.match(_h2(hash));
+							match.any(); match.clear_lowest())
+					{
+						index = (pos + match.lowest()) & this->_capacity;
+						if (this->_equal(this->_keyOf(this->_slots[index]), k))
+							return index;
+					}
+					if (group.match_empty().any())
+						return this->_capacity;
+					step += swiss_group::width;
+					pos = (pos + step) & this->_capacity;
+				}
+			}
+			// This function returns the first empty or deleted slot on the probe
+			// of a hash.
+			size_type		_findFirstNonFull(uint64_t hash) const
+			{
+				size_type	pos;
+				size_type	step;
+
+				pos = _h1(hash) & this->_capacity;
+				step = 0;
+				while (true)
+				{
+					typename swiss_group::bitmask	free
+						= swiss_group(this->_control + pos).match_empty_or_deleted();
+
+					if (free.any())
+						return (pos + free.lowest()) & this->_capacity;
+					step += swiss_group::width;
+					pos = (pos + step) & this->_capacity;
+				}
+			}
+			// This function finds the slot for a new element with this hash, and
+			// grows the table first if it has to. It returns the slot, which the
+			// caller fills in.
+			size_type		_prepareInsert(uint64_t hash)
+			{
+				size_type	index;
+
+				if (this->_capacity == 0)
+					this->_resize(_minCapacity());
+				index = this->_findFirstNonFull(hash);
+				if (this->_growthLeft == 0 && this->_control[index] != swiss_deleted)
+				{
+					// If most of the used slots are deleted ones, cleaning them up
+					// makes enough room. Otherwise, the table doubles.
+					if (this->_size < this->_growthCapacity(this->_capacity) / 2)
+						this->_resize(this->_capacity);
+					else
+						this->_resize(this->_capacity * 2 + 1);
+					index = this->_findFirstNonFull(hash);
+				}
+				if (this->_control[index] == swiss_empty)
+					this->_growthLeft--;
+				return index;
+			}
+			// This function sets the control byte of a slot, and its copy if the
+			// slot is one of the first ones.
+			void			_setControl(size_type index, unsigned char control)
+			{
+				size_type	cloned = swiss_group::width - 1;
+
+				this->_control[index] = control;
+				this->_control[((index - cloned) & this->_capacity) + (cloned & this->_capacity)] = control;
+			}
+			// This function marks an erased slot. A probe only stops at an empty
+			// byte, so if there could be a probe that went past this slot, it
+			// becomes deleted instead. That is not the case if there is an empty
+			// byte less than a group away on both sides: then every group that
+			// holds this slot has an empty byte, and was never full.
+			void			_eraseControl(size_type index)
+			{
+				size_type						before = (index - swiss_group::width) & this->_capacity;
+				typename swiss_group::bitmask	emptyAfter = swiss_group(this->_control + index).match_empty();
+				typename swiss_group::bitmask	emptyBefore = swiss_group(this->_control + before).match_empty();
+				bool							neverFull;
+
+				neverFull = emptyBefore.any() && emptyAfter.any()
+					&& emptyAfter.lowest() + emptyBefore.leading_zeros(swiss_group::width) < swiss_group::width;
+				this->_setControl(index, neverFull ? swiss_empty : swiss_deleted);
+				if (neverFull)
+					this->_growthLeft++;
+				this->_size--;
+			}
+			// This function marks all slots empty.
+			void			_resetControl()
+			{
+				std::memset(this->_control, swiss_empty, this->_capacity + swiss_group::width);
+				this->_control[this->_capacity] = swiss_sentinel;
+				this->_growthLeft = this->_growthCapacity(this->_capacity);
+			}
+			// This function moves all elements into a new table with a capacity.
+			void			_resize(size_type capacity)
+			{
+				value_type		*oldSlots = this->_slots;
+				unsigned char	*oldControl = this->_control;
+				size_type		oldCapacity = this->_capacity;
+				size_type		index;
+				uint64_t		hash;
+
+				this->_allocateTable(capacity);
+				for (size_type i = 0; i < oldCapacity; i++)
+				{
+					if (oldControl[i] >= swiss_empty)
+						continue ;
+					hash = this->_hashOf(this->_keyOf(oldSlots[i]));
+					index = this->_findFirstNonFull(hash);
+					this->_allocator.construct(&this->_slots[index], oldSlots[i]);
+					this->_allocator.destroy(&oldSlots[i]);
+					this->_setControl(index, _h2(hash));
+				}
+				this->_growthLeft -= this->_size;
+				if (oldCapacity != 0)
+				{
+					this->_allocator.deallocate(oldSlots, oldCapacity);
+					this->_controlAllocator.deallocate(oldControl, oldCapacity + swiss_group::width);
+				}
+			}
+			// This function allocates the slots and control bytes for a capacity,
+			// all empty.
+			void			_allocateTable(size_type capacity)
+			{
+				this->_capacity = capacity;
+				this->_slots = this->_allocator.allocate(capacity);
+				this->_control = this->_controlAllocator.allocate(capacity + swiss_group::width);
+				this->_resetControl();
+			}
+			// This function copies the table of another one, slot by slot.
+			void			_copyTable(const swiss_table &x)
+			{
+				if (x._capacity == 0)
+					return ;
+				this->_allocateTable(x._capacity);
+				for (size_type i = 0; i < this->_capacity; i++)
+					if (x._control[i] < swiss_empty)
+						this->_allocator.construct(&this->_slots[i], x._slots[i]);
+				std::memcpy(this->_control, x._control, this->_capacity + swiss_group::width);
+				this->_size = x._size;
+				this->_growthLeft = x._growthLeft;
+			}
+			// This function destroys all elements and frees the table.
+			void			_destroyTable()
+			{
+				if (this->_capacity == 0)
+					return ;
+				this->clear();
+				this->_allocator.deallocate(this->_slots, this->_capacity);
+				this->_controlAllocator.deallocate(this->_control, this->_capacity + swiss_group::width);
+				this->_slots = 0;
+				this->_control = _emptyControl();
+				this->_capacity = 0;
+				this->_growthLeft = 0;
+			}
+	};
+
+	template <class Value, class Key, class KeyOfValue, class Hash, class Pred, class Alloc>
+	const float		swiss_table<Value, Key, KeyOfValue, Hash, Pred, Alloc>::_defaultMaxLoadFactor = 0.875f;
+}
+
+#endif
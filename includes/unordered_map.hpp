@@ -0,0 +1,696 @@
+#ifndef UNORDERED_MAP_HPP
+# define UNORDERED_MAP_HPP
+
+# include <cstddef>				// size_t, ptrdiff_t
+# include <memory>				// allocator
+# include <stdint.h>			// uint64_t
+# include "HashIterator.hpp"	// HashIterator class
+# include "hash.hpp"			// hash, enable_transparent
+# include "pair.hpp"			// pair class
+# include "utils.hpp"			// equal_to predicate, swap
+
+namespace ft
+{
+	// A hash map with open addressing and Robin Hood probing. All elements
+	// are in one array of slots. An element goes into the first free slot at
+	// or after its home slot, but on the way it takes the slot of any element
+	// that is closer to its own home, and that element moves on instead. That
+	// keeps every element close to its home, and it means a lookup can stop
+	// as soon as it finds an element that is closer to its home than the key
+	// would be.
+	// Every slot has a control byte: 0x80 if the slot is free, or the distance
+	// of its element from its home. A distance of 0x7F or more is stored as
+	// 0x7F, and a lookup that gets there has to keep probing. Erasing shifts
+	// the elements after it back by one slot, so there are no tombstones. The
+	// array doesn't wrap around: it has some room after the last home slot,
+	// and if the elements would run past the end of it, the table grows. If
+	// the table is less than half full, only the room at the end grows, so a
+	// hash that sends many keys to one home makes long probes, but not a huge
+	// table.
+	template <class Key,
+			 class T,
+			 class Hash = ft::hash<Key>,
+			 class Pred = ft::equal_to<Key>,
+			 class Alloc = std::allocator<ft::pair<const Key, T> > >
+	class unordered_map
+	{
+		//////////////////
+		// MEMBER TYPES //
+		//////////////////
+		public:
+			typedef Key														key_type;
+			typedef T														mapped_type;
+			typedef ft::pair<const key_type, mapped_type>					value_type;
+			typedef Hash													hasher;
+			typedef Pred													key_equal;
+			typedef Alloc													allocator_type;
+			typedef typename allocator_type::reference						reference;
+			typedef typename allocator_type::const_reference				const_reference;
+			typedef typename allocator_type::pointer						pointer;
+			typedef typename allocator_type::const_pointer					const_pointer;
+			typedef HashIterator<value_type>								iterator;
+			typedef HashIterator<value_type, const value_type*, const value_type&>	const_iterator;
+			typedef std::ptrdiff_t											difference_type;
+			typedef std::size_t												size_type;
+			typedef typename allocator_type::template rebind<unsigned char>::other	ControlAlloc;
+
+		//////////////////////
+		// MEMBER FUNCTIONS //
+		//////////////////////
+		public:
+			//////////////////
+			// CONSTRUCTORS //
+			//////////////////
+			// Default constructor
+			explicit unordered_map(size_type n = 0, const hasher &hf = hasher(),
+					const key_equal &eql = key_equal(),
+					const allocator_type &alloc = allocator_type())
+				: _allocator(alloc), _controlAllocator(alloc), _hash(hf), _equal(eql),
+					_slots(0), _control(_emptyControl()), _capacity(0), _probeLimit(0),
+					_shift(0), _size(0), _maxLoadFactor(_defaultMaxLoadFactor)
+			{
+				if (n != 0)
+					this->rehash(n);
+			}
+			// Range constructor
+			template <class InputIterator>
+			unordered_map(InputIterator first, InputIterator last, size_type n = 0,
+					const hasher &hf = hasher(), const key_equal &eql = key_equal(),
+					const allocator_type &alloc = allocator_type(),
+					typename ft::iterator_traits<InputIterator>::iterator_category* = 0)
+				: _allocator(alloc), _controlAllocator(alloc), _hash(hf), _equal(eql),
+					_slots(0), _control(_emptyControl()), _capacity(0), _probeLimit(0),
+					_shift(0), _size(0), _maxLoadFactor(_defaultMaxLoadFactor)
+			{
+				if (n != 0)
+					this->rehash(n);
+				this->insert(first, last);
+			}
+			// Copy constructor
+			unordered_map(const unordered_map &x)
+				: _allocator(x._allocator), _controlAllocator(x._controlAllocator),
+					_hash(x._hash), _equal(x._equal), _slots(0), _control(_emptyControl()),
+					_capacity(0), _probeLimit(0), _shift(0), _size(0),
+					_maxLoadFactor(x._maxLoadFactor)
+			{
+				this->_copyTable(x);
+			}
+			////////////////
+			// DESTRUCTOR //
+			////////////////
+			virtual ~unordered_map()
+			{
+				this->_destroyTable();
+			}
+
+			/////////////////////////
+			// ASSIGNMENT OVERLOAD //
+			/////////////////////////
+			unordered_map	&operator=(const unordered_map &x)
+			{
+				if (this == &x)
+					return *this;
+				this->_destroyTable();
+				this->_hash = x._hash;
+				this->_equal = x._equal;
+				this->_maxLoadFactor = x._maxLoadFactor;
+				this->_copyTable(x);
+				return *this;
+			}
+
+			///////////////
+			// ITERATORS //
+			///////////////
+			// Begin
+			iterator		begin()
+			{
+				return iterator(this->_slots, this->_control);
+			}
+			// Begin (const)
+			const_iterator	begin() const
+			{
+				return const_iterator(this->_slots, this->_control);
+			}
+			// End
+			iterator		end()
+			{
+				return iterator(this->_slots + this->_slotCount(),
+						this->_control + this->_slotCount());
+			}
+			// End (const)
+			const_iterator	end() const
+			{
+				return const_iterator(this->_slots + this->_slotCount(),
+						this->_control + this->_slotCount());
+			}
+
+			//////////////
+			// CAPACITY //
+			//////////////
+			// Empty
+			bool		empty() const
+			{
+				return (this->_size == 0);
+			}
+			// Size
+			size_type	size() const
+			{
+				return this->_size;
+			}
+			// Max size
+			size_type	max_size() const
+			{
+				return this->_allocator.max_size();
+			}
+
+			////////////////////
+			// ELEMENT ACCESS //
+			////////////////////
+			// Operator []
+			mapped_type		&operator[](const key_type &k)
+			{
+				size_type	index;
+
+				index = this->_findIndex(k);
+				if (index == this->_slotCount())
+					index = this->_insertNew(value_type(k, mapped_type()));
+				return this->_slots[index].second;
+			}
+
+			///////////////
+			// MODIFIERS //
+			///////////////
+			// Insert (Single element)
+			pair<iterator, bool>	insert(const value_type &val)
+			{
+				size_type	index;
+
+				index = this->_findIndex(val.first);
+				if (index != this->_slotCount())
+					return ft::pair<iterator, bool>(this->_iteratorAt(index), false);
+				index = this->_insertNew(val);
+				return ft::pair<iterator, bool>(this->_iteratorAt(index), true);
+			}
+			// Insert (With hint). The hint is of no use to a hash table.
+			iterator				insert(iterator, const value_type &val)
+			{
+				return this->insert(val).first;
+			}
+			// Insert (Range)
+			template <class InputIterator>
+			void					insert(InputIterator first, InputIterator last,
+					typename ft::iterator_traits<InputIterator>::iterator_category* = 0)
+			{
+				while (first != last)
+				{
+					this->insert(*first);
+					first++;
+				}
+			}
+			// Erase (By iterator). Returns an iterator to the element after the
+			// erased one.
+			iterator				erase(const_iterator position)
+			{
+				size_type	index;
+
+				index = position.slot() - this->_slots;
+				this->_eraseAt(index);
+				return iterator(this->_slots + index, this->_control + index);
+			}
+			// Erase (By key)
+			size_type				erase(const key_type &k)
+			{
+				size_type	index;
+
+				index = this->_findIndex(k);
+				if (index == this->_slotCount())
+					return 0;
+				this->_eraseAt(index);
+				return 1;
+			}
+			// Erase (Iterator range). Erasing moves the elements after the gap
+			// back, and last may move with them, so this counts the elements
+			// first.
+			iterator				erase(const_iterator first, const_iterator last)
+			{
+				size_type	n;
+				iterator	it;
+
+				n = 0;
+				for (const_iterator count = first; count != last; count++)
+					n++;
+				it = iterator(const_cast<pointer>(first.slot()), first.control());
+				while (n-- > 0)
+					it = this->erase(it);
+				return it;
+			}
+			// Swap
+			void					swap(unordered_map &x)
+			{
+				ft::swap(this->_allocator, x._allocator);
+				ft::swap(this->_controlAllocator, x._controlAllocator);
+				ft::swap(this->_hash, x._hash);
+				ft::swap(this->_equal, x._equal);
+				ft::swap(this->_slots, x._slots);
+				ft::swap(this->_control, x._control);
+				ft::swap(this->_capacity, x._capacity);
+				ft::swap(this->_probeLimit, x._probeLimit);
+				ft::swap(this->_shift, x._shift);
+				ft::swap(this->_size, x._size);
+				ft::swap(this->_maxLoadFactor, x._maxLoadFactor);
+			}
+			// Clear. Keeps the slots.
+			void					clear()
+			{
+				for (size_type i = 0; i < this->_slotCount(); i++)
+				{
+					if (this->_control[i] & _free)
+						continue ;
+					this->_allocator.destroy(&this->_slots[i]);
+					this->_control[i] = _free;
+				}
+				this->_size = 0;
+			}
+
+			///////////////
+			// OBSERVERS //
+			///////////////
+			// Hash function
+			hasher			hash_function() const
+			{
+				return this->_hash;
+			}
+			// Key eq
+			key_equal		key_eq() const
+			{
+				return this->_equal;
+			}
+
+			////////////////
+			// OPERATIONS //
+			////////////////
+			// Find
+			iterator		find(const key_type &k)
+			{
+				return this->_iteratorAt(this->_findIndex(k));
+			}
+			// Find (const)
+			const_iterator	find(const key_type &k) const
+			{
+				size_type	index;
+
+				index = this->_findIndex(k);
+				return const_iterator(this->_slots + index, this->_control + index);
+			}
+			// Find (Other key type). Only if the hash and key_equal are
+			// transparent, see hash.hpp.
+			template <class K>
+			typename ft::enable_transparent<K, Hash, Pred, iterator>::type
+							find(const K &k)
+			{
+				return this->_iteratorAt(this->_findIndex(k));
+			}
+			// Find (Other key type, const)
+			template <class K>
+			typename ft::enable_transparent<K, Hash, Pred, const_iterator>::type
+							find(const K &k) const
+			{
+				size_type	index;
+
+				index = this->_findIndex(k);
+				return const_iterator(this->_slots + index, this->_control + index);
+			}
+			// Count
+			size_type		count(const key_type &k) const
+			{
+				return (this->_findIndex(k) != this->_slotCount());
+			}
+			// Equal range
+			ft::pair<iterator, iterator>				equal_range(const key_type &k)
+			{
+				iterator	first;
+				iterator	last;
+
+				first = this->find(k);
+				last = first;
+				if (first != this->end())
+					last++;
+				return ft::pair<iterator, iterator>(first, last);
+			}
+			// Equal range (const)
+			ft::pair<const_iterator, const_iterator>	equal_range(const key_type &k) const
+			{
+				const_iterator	first;
+				const_iterator	last;
+
+				first = this->find(k);
+				last = first;
+				if (first != this->end())
+					last++;
+				return ft::pair<const_iterator, const_iterator>(first, last);
+			}
+
+			/////////////////
+			// HASH POLICY //
+			/////////////////
+			// Bucket count. Every slot is a bucket of one.
+			size_type		bucket_count() const
+			{
+				return this->_capacity;
+			}
+			// Load factor
+			float			load_factor() const
+			{
+				if (this->_capacity == 0)
+					return 0;
+				return static_cast<float>(this->_size) / this->_capacity;
+			}
+			// Max load factor
+			float			max_load_factor() const
+			{
+				return this->_maxLoadFactor;
+			}
+			// Max load factor (Set). It has to be between 0.1 and 0.95, since a
+			// full table would make probes as long as the table.
+			void			max_load_factor(float z)
+			{
+				if (z < 0.1f)
+					z = 0.1f;
+				if (z > 0.95f)
+					z = 0.95f;
+				this->_maxLoadFactor = z;
+				if (this->_size > this->_capacity * z)
+					this->rehash(0);
+			}
+			// Rehash. Makes the table at least n slots big, and big enough for
+			// its elements.
+			void			rehash(size_type n)
+			{
+				size_type	capacity;
+
+				capacity = _minCapacity;
+				while (capacity < n || this->_size > capacity * this->_maxLoadFactor)
+					capacity *= 2;
+				this->_resize(capacity, this->_probeLimit);
+			}
+			// Reserve. Makes room for n elements without growing.
+			void			reserve(size_type n)
+			{
+				this->rehash(static_cast<size_type>(n / this->_maxLoadFactor) + 1);
+			}
+
+			///////////////
+			// ALLOCATOR //
+			///////////////
+			allocator_type		get_allocator() const
+			{
+				return this->_allocator;
+			}
+
+		///////////////////////
+		// PRIVATE VARIABLES //
+		///////////////////////
+		private:
+			static const unsigned char	_free = 0x80;
+			static const unsigned char	_far = 0x7F;
+			static const size_type		_minCapacity = 8;
+			static const size_type		_minProbeLimit = 16;
+			static const float			_defaultMaxLoadFactor;
+
+			allocator_type		_allocator;
+			ControlAlloc		_controlAllocator;
+			hasher				_hash;
+			key_equal			_equal;
+			value_type			*_slots;
+			unsigned char		*_control;
+			// The amount of home slots, always a power of two.
+			size_type			_capacity;
+			// The amount of slots after the last home slot. An element in the
+			// last home slot can be this far from its home, minus one.
+			size_type			_probeLimit;
+			// Shifting a mixed hash right by this much gives its home slot.
+			size_type			_shift;
+			size_type			_size;
+			float				_maxLoadFactor;
+
+		//////////////////////////////
+		// PRIVATE MEMBER FUNCTIONS //
+		//////////////////////////////
+		private:
+			// The control bytes of a table without slots: only the end.
+			static unsigned char	*_emptyControl()
+			{
+				static unsigned char	control = 0;
+
+				return &control;
+			}
+			// This function returns the amount of slots, including the ones after
+			// the last home slot.
+			size_type		_slotCount() const
+			{
+				return this->_capacity + this->_probeLimit;
+			}
+			// This function returns an iterator to a slot.
+			iterator		_iteratorAt(size_type index)
+			{
+				return iterator(this->_slots + index, this->_control + index);
+			}
+			// This function returns the home slot of a hash. The hash is
+			// multiplied by 2^64 divided by the golden ratio, and the top bits are
+			// used, so every bit of the hash has a say in the home slot.
+			size_type		_home(std::size_t hash) const
+			{
+				uint64_t	golden = (static_cast<uint64_t>(0x9E3779B9u) << 32) | 0x7F4A7C15u;
+
+				return static_cast<size_type>((static_cast<uint64_t>(hash) * golden) >> this->_shift);
+			}
+			// This function returns the slot of k, or the slot count if k isn't
+			// in the table. It stops at the first slot that is free, or whose
+			// element is closer to its home than k would be.
+			// This function returns the control byte for a distance.
+			static unsigned char	_controlOf(size_type distance)
+			{
+				if (distance >= _far)
+					return _far;
+				return static_cast<unsigned char>(distance);
+			}
+			// This function returns how far the element in a slot is from its
+			// home. The control byte doesn't say if it is 0x7F or more, so then
+			// the key is hashed again.
+			size_type		_distanceAt(size_type index) const
+			{
+				if (this->_control[index] != _far)
+					return this->_control[index];
+				return index - this->_home(this->_hash(this->_slots[index].first));
+			}
+			// This function returns the slot of k, or the slot count if k isn't
+			// in the table. It stops at the first slot that is free, or whose
+			// element is closer to its home than k would be. Past a distance of
+			// 0x7F, it can only stop at a slot that says so.
+			template <class K>
+			size_type		_findIndex(const K &k) const
+			{
+				size_type		index;
+				size_type		distance;
+
+				if (this->_size == 0)
+					return this->_slotCount();
+				index = this->_home(this->_hash(k));
+				for (distance = 0; !(this->_control[index] & _free)
+						&& (this->_control[index] >= distance || this->_control[index] == _far);
+						distance++, index++)
+				{
+					if (this->_control[index] == _controlOf(distance)
+							&& this->_equal(this->_slots[index].first, k))
+						return index;
+				}
+				return this->_slotCount();
+			}
+			// This function adds an element that isn't in the table yet, growing
+			// the table first if it would get too full, and returns its slot. If
+			// the elements would run past the end of the slots, a table that is
+			// at least half full doubles, and one that isn't only gets more room
+			// at the end.
+			size_type		_insertNew(const value_type &val)
+			{
+				size_type	index;
+
+				if (this->_size + 1 > this->_capacity * this->_maxLoadFactor)
+					this->rehash(this->_capacity * 2);
+				index = this->_place(val);
+				while (index == this->_slotCount())
+				{
+					if (this->_size * 2 >= this->_capacity * this->_maxLoadFactor)
+						this->_resize(this->_capacity * 2, this->_probeLimit);
+					else
+						this->_resize(this->_capacity, this->_probeLimit * 2);
+					index = this->_place(val);
+				}
+				this->_size++;
+				return index;
+			}
+			// This function puts an element into the table, and returns its slot.
+			// It goes past the elements that are as far or further from their
+			// home, and takes the slot of the first one that is closer. That
+			// element and the ones after it up to the next free slot all move
+			// one slot on. If that would go past the last slot, nothing changes
+			// and the slot count is returned.
+			size_type		_place(const value_type &val)
+			{
+				size_type	index;
+				size_type	distance;
+				size_type	last;
+
+				index = this->_home(this->_hash(val.first));
+				distance = 0;
+				while (!(this->_control[index] & _free) && this->_distanceAt(index) >= distance)
+				{
+					index++;
+					distance++;
+				}
+				for (last = index; !(this->_control[last] & _free); last++)
+				{
+					if (last == this->_slotCount())
+						return this->_slotCount();
+				}
+				for (; last > index; last--)
+				{
+					this->_control[last] = (this->_control[last - 1] == _far) ? _far
+						: this->_control[last - 1] + 1;
+					this->_allocator.construct(&this->_slots[last], this->_slots[last - 1]);
+					this->_allocator.destroy(&this->_slots[last - 1]);
+				}
+				this->_allocator.construct(&this->_slots[index], val);
+				this->_control[index] = _controlOf(distance);
+				return index;
+			}
+			// This function erases the element in a slot, and moves the elements
+			// after it one slot back, up to the first one that is free or already
+			// in its home.
+			void			_eraseAt(size_type index)
+			{
+				this->_allocator.destroy(&this->_slots[index]);
+				while (!(this->_control[index + 1] & _free) && this->_control[index + 1] > 0)
+				{
+					this->_control[index] = _controlOf(this->_distanceAt(index + 1) - 1);
+					this->_allocator.construct(&this->_slots[index], this->_slots[index + 1]);
+					this->_allocator.destroy(&this->_slots[index + 1]);
+					index++;
+				}
+				this->_control[index] = _free;
+				this->_size--;
+			}
+			// This function moves all elements into a table with a new capacity,
+			// and at least probeLimit slots after the last home slot. If the
+			// elements don't fit, it tries again with twice as many slots at the
+			// end.
+			void			_resize(size_type capacity, size_type probeLimit)
+			{
+				unordered_map	bigger(0, this->_hash, this->_equal, this->_allocator);
+				size_type		i;
+
+				bigger._maxLoadFactor = this->_maxLoadFactor;
+				bigger._allocateTable(capacity, probeLimit);
+				for (i = 0; i < this->_slotCount(); i++)
+				{
+					if (this->_control[i] & _free)
+						continue ;
+					if (bigger._place(this->_slots[i]) == bigger._slotCount())
+						break ;
+					bigger._size++;
+				}
+				if (i < this->_slotCount())
+					return this->_resize(capacity, bigger._probeLimit * 2);
+				this->swap(bigger);
+			}
+			// This function allocates the slots and control bytes for a capacity.
+			// The slots after the last home slot grow with the table, and there
+			// are at least probeLimit of them.
+			void			_allocateTable(size_type capacity, size_type probeLimit)
+			{
+				size_type	bits;
+
+				bits = 0;
+				while ((static_cast<size_type>(1) << bits) < capacity)
+					bits++;
+				this->_capacity = capacity;
+				this->_shift = 64 - bits;
+				this->_probeLimit = (2 * bits < _minProbeLimit) ? _minProbeLimit : 2 * bits;
+				if (this->_probeLimit < probeLimit)
+					this->_probeLimit = probeLimit;
+				this->_slots = this->_allocator.allocate(this->_slotCount());
+				this->_control = this->_controlAllocator.allocate(this->_slotCount() + 1);
+				for (size_type i = 0; i < this->_slotCount(); i++)
+					this->_control[i] = _free;
+				this->_control[this->_slotCount()] = 0;
+			}
+			// This function copies the table of another map, slot by slot.
+			void			_copyTable(const unordered_map &x)
+			{
+				if (x._capacity == 0)
+					return ;
+				this->_allocateTable(x._capacity, x._probeLimit);
+				for (size_type i = 0; i < this->_slotCount(); i++)
+				{
+					if (x._control[i] & _free)
+						continue ;
+					this->_allocator.construct(&this->_slots[i], x._slots[i]);
+					this->_control[i] = x._control[i];
+				}
+				this->_size = x._size;
+			}
+			// This function destroys all elements and frees the table.
+			void			_destroyTable()
+			{
+				if (this->_capacity == 0)
+					return ;
+				this->clear();
+				this->_allocator.deallocate(this->_slots, this->_slotCount());
+				this->_controlAllocator.deallocate(this->_control, this->_slotCount() + 1);
+				this->_slots = 0;
+				this->_control = _emptyControl();
+				this->_capacity = 0;
+				this->_probeLimit = 0;
+			}
+	};
+
+	template <class Key, class T, class Hash, class Pred, class Alloc>
+	const float		unordered_map<Key, T, Hash, Pred, Alloc>::_defaultMaxLoadFactor = 0.875f;
+
+	//////////////////////////
+	// RELATIONAL OPERATORS //
+	//////////////////////////
+	// == operator
+	template <class Key, class T, class Hash, class Pred, class Alloc>
+	bool		operator==(const unordered_map<Key, T, Hash, Pred, Alloc> &lhs,
+							const unordered_map<Key, T, Hash, Pred, Alloc> &rhs)
+	{
+		typename unordered_map<Key, T, Hash, Pred, Alloc>::const_iterator	lhsit, rhsit;
+
+		if (lhs.size() != rhs.size())
+			return false;
+		for (lhsit = lhs.begin(); lhsit != lhs.end(); lhsit++)
+		{
+			rhsit = rhs.find(lhsit->first);
+			if (rhsit == rhs.end() || !(rhsit->second == lhsit->second))
+				return false;
+		}
+		return true;
+	}
+	// != operator
+	template <class Key, class T, class Hash, class Pred, class Alloc>
+	bool		operator!=(const unordered_map<Key, T, Hash, Pred, Alloc> &lhs,
+							const unordered_map<Key, T, Hash, Pred, Alloc> &rhs)
+	{
+		return !(lhs == rhs);
+	}
+	// Swap
+	template <class Key, class T, class Hash, class Pred, class Alloc>
+	void		swap(unordered_map<Key, T, Hash, Pred, Alloc> &lhs,
+					unordered_map<Key, T, Hash, Pred, Alloc> &rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
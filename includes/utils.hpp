@@ -38,6 +38,36 @@ namespace ft
 		}
 	};
 
+	// Equal to will be used as the default key_equal of the unordered
+	// containers.
+	template <class T>
+	struct equal_to
+	{
+		bool operator() (const T &x, const T &y) const
+		{
+			return (x == y);
+		}
+	};
+
+	// Select first and identity get the key out of an element, for containers
+	// that are shared between a map and a set.
+	template <class Pair>
+	struct select_first
+	{
+		const typename Pair::first_type	&operator() (const Pair &x) const
+		{
+			return x.first;
+		}
+	};
+	template <class T>
+	struct identity
+	{
+		const T		&operator() (const T &x) const
+		{
+			return x;
+		}
+	};
+
 	// Generic swap function
 	template <class T>
 	void		swap(T &first, T &second)
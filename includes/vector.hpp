@@ -2,16 +2,23 @@
 # define VECTOR_HPP
 
 #include <cstddef>						// size_t, ptrdiff_t
+#include <cstdlib>						// realloc, free
+#include <cstring>						// memcpy, memmove
 #include <memory>						// allocator
+#include <new>							// bad_alloc exception
 #include <stdexcept>					// out_of_range exception
 #include "RandomAccessIterator.hpp"		// RandomAccessIterator class
 #include "ReverseIterator.hpp"			// ReverseIterator class
+#include "growth_policy.hpp"			// double_growth
+#include "is_same.hpp"					// is_same
+#include "is_trivially_copyable.hpp"	// is_trivially_copyable
 #include "iterator_traits.hpp"			// Iterator traits
 #include "utils.hpp"					// Swap, lexicographical_compare
 
 namespace ft
 {
-	template <class T, class Alloc = std::allocator<T> >
+	// The Growth parameter picks how the capacity grows, see growth_policy.hpp.
+	template <class T, class Alloc = std::allocator<T>, class Growth = ft::double_growth>
 	class vector
 	{
 		//////////////////
@@ -20,6 +27,7 @@ namespace ft
 		public:
 			typedef T											value_type;
 			typedef Alloc										allocator_type;
+			typedef Growth										growth_policy;
 			typedef typename allocator_type::reference			reference;
 			typedef typename allocator_type::const_reference	const_reference;
 			typedef typename allocator_type::pointer			pointer;
@@ -149,7 +157,7 @@ namespace ft
 				if (n < this->_size)
 				{
 					for (size_type i = this->_size; i > n; i--)
-						this->_destroyElement(i);
+						this->_destroyElement(i - 1);
 				}
 				else if (n > this->_size)
 				{
@@ -173,6 +181,20 @@ namespace ft
 			{
 				this->_increaseCapacity(n, true);
 			}
+			// Shrink to fit
+			void			shrink_to_fit()
+			{
+				if (this->_capacity == this->_size)
+					return ;
+				if (this->_size == 0)
+				{
+					this->_deallocate();
+					this->_elements = NULL;
+					this->_capacity = 0;
+					return ;
+				}
+				this->_reallocate(this->_size);
+			}
 
 			////////////////////
 			// ELEMENT ACCESS //
@@ -293,7 +315,7 @@ namespace ft
 			{
 				difference_type		pos = ft::distance(this->begin(), position);
 				size_t				amountToMove = 1;
-				size_t				elements = this->_size - pos;
+				size_t				elements = this->_size - pos - 1;
 
 				this->_destroyElement(pos);
 				this->_moveElementsBackward(pos + amountToMove, elements, amountToMove);
@@ -348,6 +370,12 @@ namespace ft
 			size_type		_size;
 			size_type		_capacity;
 
+			// Trivially copyable elements can be moved around as raw bytes. When
+			// the default allocator is used as well, the buffer is managed with
+			// malloc and realloc instead, so it can often grow in place.
+			static const bool	_trivial = ft::is_trivially_copyable<T>::value;
+			static const bool	_usesRealloc = _trivial && ft::is_same<Alloc, std::allocator<T> >::value;
+
 		//////////////////////////////
 		// PRIVATE MEMBER FUNCTIONS //
 		//////////////////////////////
@@ -369,7 +397,7 @@ namespace ft
 				for (size_type i = 0; i < amount; i++)
 					this->_destroyElement(i);
 				if (deallocate)
-					this->_allocator.deallocate(this->_elements, this->_capacity);
+					this->_deallocate();
 			}
 			// This function destructs a single element, given the index,
 			// using the allocator, but does not deallocate.
@@ -379,101 +407,154 @@ namespace ft
 				this->_size--;
 			}
 			// This function will increase the allocated space for this vector.
+			// Unless exact is true, the growth policy decides the new capacity.
 			void	_increaseCapacity(size_type newCapacity, bool exact = false)
 			{
-				pointer		tmp;
-				size_type	tmpSize;
-
 				if (newCapacity <= this->_capacity)
 					return ;
 				if (!exact)
+					newCapacity = Growth::grow(this->_capacity, newCapacity, sizeof(T));
+				this->_reallocate(newCapacity);
+			}
+			// This function moves the elements into a buffer that has room for
+			// newCapacity elements. The buffer may also shrink, as long as the
+			// elements still fit.
+			void	_reallocate(size_type newCapacity)
+			{
+				pointer		tmp;
+
+				if (_usesRealloc)
 				{
-					if (newCapacity != 1 && !(newCapacity >= this->_capacity * 2))
-						newCapacity = this->_capacity * 2;
+					// For big buffers, glibc's realloc remaps the pages (mremap)
+					// instead of copying them.
+					tmp = static_cast<pointer>(std::realloc(static_cast<void *>(this->_elements), newCapacity * sizeof(T)));
+					if (tmp == NULL)
+						throw std::bad_alloc();
 				}
-				tmp = this->_allocator.allocate(newCapacity);
-				if (this->_size != 0)
+				else
 				{
-					tmpSize = this->_size;
-					for (size_type i = 0; i < this->_size; i++)
-						this->_allocator.construct(&tmp[i], this->_elements[i]);
-					this->_destroyElements(true);
-					this->_size = tmpSize;
+					tmp = this->_allocator.allocate(newCapacity);
+					this->_relocate(tmp, this->_elements, this->_size);
+					this->_deallocate();
 				}
-				else
-					this->_destroyElements(true);
 				this->_elements = tmp;
 				this->_capacity = newCapacity;
 			}
+			// This function moves n elements from src to the uninitialized memory
+			// at dst. Afterwards, the elements at src are destroyed.
+			void	_relocate(pointer dst, pointer src, size_type n)
+			{
+				if (_trivial)
+				{
+					if (n != 0)
+						std::memcpy(static_cast<void *>(dst), static_cast<const void *>(src), n * sizeof(T));
+					return ;
+				}
+				for (size_type i = 0; i < n; i++)
+				{
+					this->_allocator.construct(&dst[i], src[i]);
+					this->_allocator.destroy(&src[i]);
+				}
+			}
+			// This function gives the buffer back to where it came from. It does
+			// not destroy the elements.
+			void	_deallocate()
+			{
+				if (this->_elements == NULL)
+					return ;
+				if (_usesRealloc)
+					std::free(this->_elements);
+				else
+					this->_allocator.deallocate(this->_elements, this->_capacity);
+			}
 			// This function will move elements in the array, starting at index
 			// startIndex, forward by a specified amount of spaces.
 			void	_moveElementsForward(size_type startIndex, size_type amount)
 			{
-				for (size_type i = this->_size - 1; i > startIndex - 1; i--)
+				if (_trivial)
 				{
-					this->_addNewValue(i + amount, this->_elements[i]);
-					this->_destroyElement(i);
+					this->_moveMemory(startIndex + amount, startIndex, this->_size - startIndex);
+					return ;
+				}
+				for (size_type i = this->_size; i > startIndex; i--)
+				{
+					this->_addNewValue(i - 1 + amount, this->_elements[i - 1]);
+					this->_destroyElement(i - 1);
 				}
 			}
 			// This function will move elements in the array, starting at index
 			// startIndex, backward by a specified amount of spaces.
 			void	_moveElementsBackward(size_type startIndex, size_type elements, size_type amountToMove)
 			{
+				if (_trivial)
+				{
+					this->_moveMemory(startIndex - amountToMove, startIndex, elements);
+					return ;
+				}
 				for (size_type i = startIndex; i < startIndex + elements; i++)
 				{
 					this->_addNewValue(i - amountToMove, this->_elements[i]);
 					this->_destroyElement(i);
 				}
 			}
+			// This function moves a block of trivially copyable elements within
+			// the array. The source and destination may overlap.
+			void	_moveMemory(size_type dst, size_type src, size_type elements)
+			{
+				if (elements == 0)
+					return ;
+				std::memmove(static_cast<void *>(&this->_elements[dst]),
+					static_cast<const void *>(&this->_elements[src]), elements * sizeof(T));
+			}
 	};
 
 	//////////////////////////
 	// RELATIONAL OPERATORS //
 	//////////////////////////
 	// == operator
-	template <class T, class Alloc>
-	bool		operator==(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	template <class T, class Alloc, class Growth>
+	bool		operator==(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
 	{
 		if (lhs.size() != rhs.size())
 			return false;
-		for (typename vector<T>::size_type i = 0; i < lhs.size(); i++)
+		for (typename vector<T, Alloc, Growth>::size_type i = 0; i < lhs.size(); i++)
 			if (lhs[i] != rhs[i])
 				return false;
 		return true;
 	}
 	// != operator
-	template <class T, class Alloc>
-	bool		operator!=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	template <class T, class Alloc, class Growth>
+	bool		operator!=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
 	{
 		return !(lhs == rhs);
 	}
 	// < operator
-	template <class T, class Alloc>
-	bool		operator<(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	template <class T, class Alloc, class Growth>
+	bool		operator<(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
 	{
 		return lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 	}
 	// <= operator
-	template <class T, class Alloc>
-	bool		operator<=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	template <class T, class Alloc, class Growth>
+	bool		operator<=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
 	{
 		return !(rhs < lhs);
 	}
 	// > operator
-	template <class T, class Alloc>
-	bool		operator>(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	template <class T, class Alloc, class Growth>
+	bool		operator>(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
 	{
 		return (rhs < lhs);
 	}
 	// >= operator
-	template <class T, class Alloc>
-	bool		operator>=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+	template <class T, class Alloc, class Growth>
+	bool		operator>=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
 	{
 		return !(lhs < rhs);
 	}
 	// Swap
-	template <class T, class Alloc>
-	void		swap(vector<T, Alloc> &x, vector<T, Alloc> &y)
+	template <class T, class Alloc, class Growth>
+	void		swap(vector<T, Alloc, Growth> &x, vector<T, Alloc, Growth> &y)
 	{
 		x.swap(y);
 	}
@@ -0,0 +1,106 @@
+#ifndef WAIT_STRATEGY_HPP
+# define WAIT_STRATEGY_HPP
+
+# include <pthread.h>			// mutex, condition variable
+# include <sched.h>				// sched_yield
+# include "atomic.hpp"			// atomic operations
+
+namespace ft
+{
+	// Wait strategies decide what a thread does once it has spun for a while
+	// on a concurrent container, waiting for room or for an element. A
+	// container keeps one per condition it waits for. A waiting thread calls
+	// prepare_wait, tries again, and only then calls wait with the ticket it
+	// got, followed by finish_wait. Every thread that changes the container
+	// in a way that someone might wait for calls notify afterwards.
+
+	// Keeps the thread runnable, but gives its time slice away while it
+	// waits. Notifying costs nothing.
+	class spin_wait
+	{
+		public:
+			// Prepare wait
+			unsigned int	prepare_wait()
+			{
+				return 0;
+			}
+			// Wait
+			void			wait(unsigned int)
+			{
+				sched_yield();
+			}
+			// Finish wait
+			void			finish_wait()
+			{
+			}
+			// Notify
+			void			notify()
+			{
+			}
+	};
+
+	// Puts the thread to sleep on a condition variable while it waits. The
+	// epoch goes up on every notify that happens while threads are waiting,
+	// and a thread only sleeps while the epoch is still the one it saw before
+	// it tried again, so no wakeup is lost. A notify without waiters costs a
+	// memory fence and a load.
+	class blocking_wait
+	{
+		public:
+			// Default constructor
+			blocking_wait() : _waiters(0), _epoch(0)
+			{
+				pthread_mutex_init(&this->_mutex, NULL);
+				pthread_cond_init(&this->_cond, NULL);
+			}
+			// Destructor
+			~blocking_wait()
+			{
+				pthread_cond_destroy(&this->_cond);
+				pthread_mutex_destroy(&this->_mutex);
+			}
+			// Prepare wait
+			unsigned int	prepare_wait()
+			{
+				ft::atomic_fetch_add(&this->_waiters, 1u, ft::memory_order_seq_cst);
+				ft::atomic_thread_fence(ft::memory_order_seq_cst);
+				return ft::atomic_load(&this->_epoch, ft::memory_order_seq_cst);
+			}
+			// Wait
+			void			wait(unsigned int ticket)
+			{
+				pthread_mutex_lock(&this->_mutex);
+				while (ft::atomic_load(&this->_epoch, ft::memory_order_relaxed) == ticket)
+					pthread_cond_wait(&this->_cond, &this->_mutex);
+				pthread_mutex_unlock(&this->_mutex);
+			}
+			// Finish wait
+			void			finish_wait()
+			{
+				ft::atomic_fetch_add(&this->_waiters, -1u, ft::memory_order_relaxed);
+			}
+			// Notify
+			void			notify()
+			{
+				ft::atomic_thread_fence(ft::memory_order_seq_cst);
+				if (ft::atomic_load(&this->_waiters, ft::memory_order_relaxed) == 0)
+					return ;
+				pthread_mutex_lock(&this->_mutex);
+				ft::atomic_fetch_add(&this->_epoch, 1u, ft::memory_order_relaxed);
+				pthread_cond_broadcast(&this->_cond);
+				pthread_mutex_unlock(&this->_mutex);
+			}
+
+		private:
+			unsigned int		_waiters;
+			unsigned int		_epoch;
+			pthread_mutex_t		_mutex;
+			pthread_cond_t		_cond;
+
+			// A strategy can't be copied while threads are waiting on it.
+			blocking_wait(const blocking_wait &);
+			blocking_wait	&operator=(const blocking_wait &);
+	};
+}
+
+#endif
@@ -1,49 +1,285 @@
+#include <cctype>
+#include <cstdlib>
 #include <iostream>
-#include <fstream>
-#include <iomanip>
+#include <iterator>
+#include <pthread.h>
+#include <sched.h>
+#include <sstream>
 #include <string>
-#include <sys/time.h>
 
 #ifdef USE_STD
+# include <deque>
+# include <list>
 # include <map>
+# include <queue>
+# include <set>
 # include <stack>
 # include <vector>
 # define LEAKCHECK "leaks std_containers"
-# define TIMEFILE "times_std.txt"
+# define POOL_ALLOCATOR std::allocator
+# define GROWTH_VECTOR(type, growth) std::vector<type>
+# define SPSC_QUEUE LockedQueue
+# define MPMC_QUEUE(type, size) LockedQueue<type, size>
+# define BLOCKING_MPMC_QUEUE(type, size) LockedQueue<type, size>
+# define LOCKFREE_STACK LockedStack
+# define FLAT_MAP std::map
+# define HASH_MAP(key, value) std::map<key, value>
+# define STRING_HASH_MAP(value) std::map<std::string, value>
+# define CONSTANT_HASH_MAP(key, value) std::map<key, value>
+# define FLAT_HASH_MAP(key, value) std::map<key, value>
+# define FLAT_HASH_SET(key) std::set<key>
+# define RANK_MAP(key, value) std::map<key, value>
+# define INTERVAL_MAP(point, value) ScannedIntervalMap<point, value>
+# define COMPARED_INTERVAL_MAP(point, value, compare) ScannedIntervalMap<point, value, compare>
+# define PERSISTENT_MAP(key, value) CopiedMap<key, value>
 	namespace ft = std;
 #else
+# include "deque.hpp"
+# include "flat_hash_map.hpp"
+# include "flat_hash_set.hpp"
+# include "flat_map.hpp"
+# include "interval_map.hpp"
+# include "list.hpp"
+# include "lockfree_stack.hpp"
 # include "map.hpp"
+# include "persistent_map.hpp"
+# include "pool_allocator.hpp"
+# include "queue.hpp"
+# include "mpmc_queue.hpp"
+# include "spsc_queue.hpp"
 # include "stack.hpp"
+# include "unordered_map.hpp"
 # include "vector.hpp"
 # define LEAKCHECK "leaks ft_containers"
-# define TIMEFILE "times_ft.txt"
+# define POOL_ALLOCATOR ft::pool_allocator
+# define GROWTH_VECTOR(type, growth) ft::vector<type, std::allocator<type>, ft::growth>
+# define SPSC_QUEUE ft::spsc_queue
+# define MPMC_QUEUE(type, size) ft::mpmc_queue<type, size>
+# define BLOCKING_MPMC_QUEUE(type, size) ft::mpmc_queue<type, size, ft::blocking_wait>
+# define LOCKFREE_STACK ft::lockfree_stack
+# define FLAT_MAP ft::flat_map
+# define HASH_MAP(key, value) ft::unordered_map<key, value>
+# define STRING_HASH_MAP(value) ft::unordered_map<std::string, value, ft::string_hash, ft::string_equal>
+# define CONSTANT_HASH_MAP(key, value) ft::unordered_map<key, value, ConstantHash>
+# define FLAT_HASH_MAP(key, value) ft::flat_hash_map<key, value>
+# define FLAT_HASH_SET(key) ft::flat_hash_set<key>
+# define RANK_MAP(key, value) ft::map<key, value, ft::less<key>, \
+	std::allocator<ft::pair<const key, value> >, ft::order_statistics>
+# define INTERVAL_MAP(point, value) ft::interval_map<point, value>
+# define COMPARED_INTERVAL_MAP(point, value, compare) ft::interval_map<point, value, compare>
+# define PERSISTENT_MAP(key, value) ft::persistent_map<key, value>
 #endif
 
-// This logger class is used to log the execution time of functions to a file.
-class Logger
+#ifdef USE_STD
+// The std library has no concurrent queues. This bounded queue with a lock has
+// the same interface, so the concurrent tests give the same output with it.
+template <class T, size_t N>
+class LockedQueue
+{
+	public:
+		LockedQueue()
+		{
+			pthread_mutex_init(&_mutex, NULL);
+		}
+		~LockedQueue()
+		{
+			pthread_mutex_destroy(&_mutex);
+		}
+
+		bool	try_push(const T &val)
+		{
+			return (this->push_n(&val, 1) == 1);
+		}
+		size_t	push_n(const T *values, size_t n)
+		{
+			size_t	i;
+
+			pthread_mutex_lock(&_mutex);
+			for (i = 0; i < n && _queue.size() < N; i++)
+				_queue.push(values[i]);
+			pthread_mutex_unlock(&_mutex);
+			return i;
+		}
+		void	push(const T &val)
+		{
+			while (!this->try_push(val))
+				sched_yield();
+		}
+		bool	try_pop(T &val)
+		{
+			return (this->pop_n(&val, 1) == 1);
+		}
+		void	pop(T &val)
+		{
+			while (!this->try_pop(val))
+				sched_yield();
+		}
+		size_t	pop_n(T *values, size_t n)
+		{
+			size_t	i;
+
+			pthread_mutex_lock(&_mutex);
+			for (i = 0; i < n && !_queue.empty(); i++)
+			{
+				values[i] = _queue.front();
+				_queue.pop();
+			}
+			pthread_mutex_unlock(&_mutex);
+			return i;
+		}
+		bool	empty()
+		{
+			return (this->size() == 0);
+		}
+		size_t	size()
+		{
+			size_t	result;
+
+			pthread_mutex_lock(&_mutex);
+			result = _queue.size();
+			pthread_mutex_unlock(&_mutex);
+			return result;
+		}
+		size_t	capacity()
+		{
+			return N;
+		}
+
+	private:
+		std::queue<T>		_queue;
+		pthread_mutex_t		_mutex;
+};
+
+// The same for the lock-free stack.
+template <class T>
+class LockedStack
 {
 	public:
-		Logger()
+		LockedStack()
+		{
+			pthread_mutex_init(&_mutex, NULL);
+		}
+		~LockedStack()
+		{
+			pthread_mutex_destroy(&_mutex);
+		}
+
+		void	push(const T &val)
+		{
+			pthread_mutex_lock(&_mutex);
+			_stack.push(val);
+			pthread_mutex_unlock(&_mutex);
+		}
+		bool	try_pop(T &val)
 		{
-			_timeFile.open(TIMEFILE);
-			_timeFile << std::fixed << std::setprecision(0);
+			bool	popped;
+
+			pthread_mutex_lock(&_mutex);
+			popped = !_stack.empty();
+			if (popped)
+			{
+				val = _stack.top();
+				_stack.pop();
+			}
+			pthread_mutex_unlock(&_mutex);
+			return popped;
+		}
+		void	pop()
+		{
+			pthread_mutex_lock(&_mutex);
+			_stack.pop();
+			pthread_mutex_unlock(&_mutex);
+		}
+		T		&top()
+		{
+			return _stack.top();
 		}
-		~Logger()
+		bool	empty()
 		{
-			_timeFile.close();
+			bool	result;
+
+			pthread_mutex_lock(&_mutex);
+			result = _stack.empty();
+			pthread_mutex_unlock(&_mutex);
+			return result;
 		}
 
-		void	time(std::string const &name, double time)
+	private:
+		std::stack<T>		_stack;
+		pthread_mutex_t		_mutex;
+};
+
+// The std library has no interval map either. This one is a map of intervals
+// that looks at every interval to answer a query. The intervals are only
+// stored in the order of the pairs, but the queries use the point compare.
+template <class Point, class T, class Compare = std::less<Point> >
+class ScannedIntervalMap : public std::map<std::pair<Point, Point>, T>
+{
+	public:
+		typedef std::map<std::pair<Point, Point>, T>	base_map;
+		typedef typename base_map::iterator				iterator;
+
+		ScannedIntervalMap(const Compare &comp = Compare()) : _comp(comp)
+		{
+		}
+		using base_map::insert;
+		std::pair<iterator, bool>	insert(const Point &start, const Point &end, const T &val)
+		{
+			return this->insert(std::make_pair(std::make_pair(start, end), val));
+		}
+		template <class OutputIterator>
+		OutputIterator	overlaps(const Point &a, const Point &b, OutputIterator out)
 		{
-			_timeFile << std::setw(30) << std::left;
-			_timeFile << name + ":";
-			_timeFile << std::setw(10) << std::right;
-			_timeFile << time << std::endl;
+			for (iterator it = this->begin(); it != this->end(); it++)
+			{
+				if (!this->_comp(b, it->first.first) && !this->_comp(it->first.second, a))
+				{
+					*out = it;
+					++out;
+				}
+			}
+			return out;
+		}
+		template <class OutputIterator>
+		OutputIterator	stab(const Point &p, OutputIterator out)
+		{
+			return this->overlaps(p, p, out);
+		}
+		iterator		first_overlap(const Point &a, const Point &b)
+		{
+			for (iterator it = this->begin(); it != this->end(); it++)
+				if (!this->_comp(b, it->first.first) && !this->_comp(it->first.second, a))
+					return it;
+			return this->end();
 		}
 
 	private:
-		std::ofstream	_timeFile;
+		Compare		_comp;
+};
+
+// A std::map can only be snapshotted by copying all of it.
+template <class Key, class T>
+class CopiedMap : public std::map<Key, T>
+{
+	public:
+		typedef std::map<Key, T>				base_map;
+		typedef typename base_map::iterator		iterator;
+
+		CopiedMap	snapshot() const
+		{
+			return *this;
+		}
+		std::pair<iterator, bool>	insert_or_assign(const Key &k, const T &obj)
+		{
+			std::pair<iterator, bool>	result;
+
+			result = this->insert(std::make_pair(k, obj));
+			if (!result.second)
+				result.first->second = obj;
+			return result;
+		}
 };
+#endif
 
 // This function can be used to check for leaks at the end of the program.
 void	checkLeaks()
@@ -483,6 +719,48 @@ void	mapBasics()
 	std::cout << "[" << it2->first << "," << it2->second << "]" << std::endl;
 }
 
+// Map iterator test. Walks maps forwards and backwards, including empty ones,
+// and checks that iterators keep working after erases and swaps.
+void	mapIterators()
+{
+	ft::map<int, int>						m1, m2;
+	ft::map<int, int>::iterator				it;
+	ft::map<int, int>::reverse_iterator		rit;
+
+	std::cout << (m1.begin() == m1.end()) << std::endl;
+	for (int i = 0; i < 10; i++)
+		m1[i * 7 % 10] = i;
+	for (it = m1.begin(); it != m1.end(); it++)
+		std::cout << it->first << " ";
+	std::cout << std::endl;
+	for (rit = m1.rbegin(); rit != m1.rend(); rit++)
+		std::cout << rit->first << " ";
+	std::cout << std::endl;
+	it = m1.end();
+	while (it != m1.begin())
+	{
+		it--;
+		std::cout << it->first << " ";
+	}
+	std::cout << std::endl;
+	it = m1.find(4);
+	m1.erase(5);
+	m1.erase(3);
+	it--;
+	std::cout << it->first << ",";
+	it++;
+	std::cout << it->first << ",";
+	it++;
+	std::cout << it->first << std::endl;
+	m1.swap(m2);
+	std::cout << (m1.begin() == m1.end()) << ", " << (m2.begin() == m2.end()) << std::endl;
+	printMap(m1);
+	printMap(m2);
+	it = m2.begin();
+	m2.clear();
+	std::cout << (m2.begin() == m2.end()) << std::endl;
+}
+
 // Map relational operators test.
 void	mapRelational()
 {
@@ -526,32 +804,1651 @@ void	mapStressTest()
 	std::cout << it->first << "," << it->second << std::endl;
 }
 
-// This typedefs 'testFunction' as a function that takes and returns nothing.
-typedef void (*testFunction)(void);
+// Map hinted insert test. Uses good hints (end, the previously inserted element,
+// begin) and bad ones, and finishes with a big sorted load using end() as hint.
+void	mapHintedInsert()
+{
+	ft::map<int, int>				m1, m2;
+	ft::map<int, int>::iterator		it;
+
+	it = m1.end();
+	for (int i = 0; i < 10; i += 2)
+		it = m1.insert(it, ft::make_pair(i, i * 10));
+	printMap(m1);
+	for (int i = 19; i > 10; i -= 2)
+		m1.insert(m1.begin(), ft::make_pair(i, i * 10));
+	printMap(m1);
+	it = m1.find(4);
+	it = m1.insert(it, ft::make_pair(5, 50));
+	std::cout << "[" << it->first << "," << it->second << "]" << std::endl;
+	it = m1.insert(it, ft::make_pair(3, 30));
+	std::cout << "[" << it->first << "," << it->second << "]" << std::endl;
+	it = m1.insert(m1.find(8), ft::make_pair(4, 400));
+	std::cout << "[" << it->first << "," << it->second << "]" << std::endl;
+	it = m1.insert(m1.end(), ft::make_pair(-1, -10));
+	std::cout << "[" << it->first << "," << it->second << "]" << std::endl;
+	printMap(m1);
 
-// This function calculates the time before and after we run a specific
-// function, and outputs it with the logger to a file.
-void	calculateTimeTaken(testFunction func, std::string const &testName, Logger &logger)
+	for (int i = 0; i < 200000; i++)
+		m2.insert(m2.end(), ft::make_pair(i, i));
+	it = m2.find(123456);
+	std::cout << m2.size() << ": [" << it->first << "," << it->second << "]" << std::endl;
+}
+
+// Map counters test. Counts random values with the bracket operator, which
+// mostly hits existing keys, and with insert, which mostly finds them too.
+void	mapCounters()
 {
-	struct timespec		begin;
-	struct timespec		end;
-	long				seconds;
-	long				nanoseconds;
-	double				time_taken;
+	ft::map<int, int>								m1;
+	ft::pair<ft::map<int, int>::iterator, bool>		insertReturn;
+	int												inserted;
 
-	clock_gettime(CLOCK_REALTIME, &begin);
-	func();
-	clock_gettime(CLOCK_REALTIME, &end);
-	seconds = end.tv_sec - begin.tv_sec;
-	nanoseconds = end.tv_nsec - begin.tv_nsec;
-	time_taken = seconds * 1e+9 + nanoseconds;
-	logger.time(testName, time_taken);
+	for (int i = 0; i < 300000; i++)
+		m1[rand() % 1000]++;
+	inserted = 0;
+	for (int i = 0; i < 300000; i++)
+	{
+		insertReturn = m1.insert(ft::make_pair(rand() % 1100, 0));
+		insertReturn.first->second++;
+		if (insertReturn.second)
+			inserted++;
+	}
+	std::cout << "Size: " << m1.size() << ", inserted: " << inserted << std::endl;
+	for (int i = 0; i < 1100; i += 100)
+		std::cout << "[" << i << "," << m1[i] << "]" << std::endl;
 }
 
-int main()
+// An input iterator that reads pairs of ints from a stream, like
+// std::istream_iterator does. It can only be walked once, and has no ->.
+class	PairReader
+{
+	public:
+		typedef std::input_iterator_tag		iterator_category;
+		typedef ft::pair<int, int>			value_type;
+		typedef std::ptrdiff_t				difference_type;
+		typedef const value_type*			pointer;
+		typedef const value_type&			reference;
+
+		PairReader() : _in(NULL)
+		{
+		}
+		PairReader(std::istream &in) : _in(&in)
+		{
+			++(*this);
+		}
+		reference	operator*() const
+		{
+			return this->_value;
+		}
+		PairReader	&operator++()
+		{
+			if (!(*this->_in >> this->_value.first >> this->_value.second))
+				this->_in = NULL;
+			return *this;
+		}
+		PairReader	operator++(int)
+		{
+			PairReader	tmp = *this;
+			++(*this);
+			return tmp;
+		}
+		bool		operator==(const PairReader &x) const
+		{
+			return this->_in == x._in;
+		}
+		bool		operator!=(const PairReader &x) const
+		{
+			return this->_in != x._in;
+		}
+
+	private:
+		std::istream	*_in;
+		value_type		_value;
+};
+
+// Map bulk construction test. Builds maps from sorted and unsorted ranges,
+// copies and assigns big maps, and inserts a range into a map that has elements.
+// Ranges that can only be read once are read from a stream.
+void	mapBulkConstruction()
+{
+	ft::vector<ft::pair<int, int> >		sorted, unsorted;
+	ft::map<int, int>::iterator			it;
+
+	for (int i = 0; i < 12; i++)
+	{
+		sorted.push_back(ft::make_pair(i * 3, i));
+		unsorted.push_back(ft::make_pair(rand() % 20, i));
+	}
+	ft::map<int, int>		m1(sorted.begin(), sorted.end());
+	ft::map<int, int>		m2(unsorted.begin(), unsorted.end());
+	printMap(m1);
+	printMap(m2);
+	m2.insert(sorted.begin(), sorted.end());
+	printMap(m2);
+	m1 = m2;
+	m1[7] = 700;
+	printMap(m1);
+	printMap(m2);
+
+	sorted.clear();
+	for (int i = 0; i < 500000; i++)
+		sorted.push_back(ft::make_pair(i * 2, i));
+	ft::map<int, int>		m3(sorted.begin(), sorted.end());
+	ft::map<int, int>		m4(m3);
+	ft::map<int, int>		m5;
+	m5 = m4;
+	it = m5.lower_bound(77777);
+	std::cout << m3.size() << ", " << m4.size() << ", " << m5.size() << std::endl;
+	std::cout << "[" << it->first << "," << it->second << "]" << std::endl;
+
+	std::istringstream		sortedStream("1 10 2 20 3 30 5 50 8 80");
+	std::istringstream		unsortedStream("4 40 1 11 9 90 2 22");
+	ft::map<int, int>		m6((PairReader(sortedStream)), PairReader());
+	printMap(m6);
+	m6.insert(PairReader(unsortedStream), PairReader());
+	printMap(m6);
+}
+
+// Map pool allocator test. Lots of inserts and erases on maps that get their
+// nodes from a pool, plus copying and swapping them.
+void	mapPoolAllocator()
+{
+	typedef ft::map<int, int, ft::less<int>, POOL_ALLOCATOR<ft::pair<const int, int> > >	pool_map;
+	pool_map					m1, m2;
+	pool_map::iterator			it;
+	long						sum;
+
+	for (int round = 0; round < 20; round++)
+	{
+		for (int i = 0; i < 20000; i++)
+			m1[rand() % 50000] = i;
+		for (int i = 0; i < 20000; i++)
+			m1.erase(rand() % 50000);
+	}
+	m2 = m1;
+	m1.clear();
+	for (int i = 0; i < 10; i++)
+		m1[i] = i;
+	m1.swap(m2);
+	sum = 0;
+	for (it = m1.begin(); it != m1.end(); it++)
+		sum += it->first + it->second;
+	std::cout << m1.size() << ", " << m2.size() << ", " << sum << std::endl;
+	for (it = m2.begin(); it != m2.end(); it++)
+		std::cout << "[" << it->first << "," << it->second << "]";
+	std::cout << std::endl;
+}
+
+// Map clear test. Clears big maps and uses them again. A pooled map that
+// shares its pool with a copy can't free the pool, and has to destroy its
+// nodes one by one.
+void	mapClear()
+{
+	typedef ft::map<int, int, ft::less<int>, POOL_ALLOCATOR<ft::pair<const int, int> > >	pool_map;
+	typedef ft::map<int, std::string>	string_map;
+	ft::map<int, int>		m1;
+	pool_map				m2;
+	string_map				m3;
+	long					sum;
+
+	for (int i = 0; i < 500000; i++)
+		m1[rand()] = i;
+	m1.clear();
+	std::cout << m1.size() << ", " << m1.empty() << ", " << (m1.begin() == m1.end()) << std::endl;
+	for (int i = 0; i < 100000; i++)
+		m2[i] = i;
+	pool_map				m4(m2);
+	m2.clear();
+	m4.erase(5);
+	sum = 0;
+	for (pool_map::iterator it = m4.begin(); it != m4.end(); it++)
+		sum += it->second;
+	std::cout << m2.size() << ", " << m4.size() << ", " << sum << std::endl;
+	m4.clear();
+	for (int i = 0; i < 10; i++)
+		m4[i] = i * 2;
+	m2 = m4;
+	m4.clear();
+	for (int i = 0; i < 1000; i++)
+		m3[i % 37] += "ab";
+	m3.clear();
+	m3[1] = "one";
+	std::cout << m2.size() << ", " << m2[9] << ", " << m4.size() << ", " << m3.size() << ", " << m3[1] << std::endl;
+}
+
+// List pool allocator test. Uses a list as a queue with a lot of churn.
+void	listPoolAllocator()
+{
+	ft::list<int, POOL_ALLOCATOR<int> >		l1, l2;
+	long									sum;
+
+	for (int i = 0; i < 100000; i++)
+		l1.push_back(i);
+	for (int round = 0; round < 20; round++)
+	{
+		for (int i = 0; i < 50000; i++)
+		{
+			l1.push_back(l1.front() + 1);
+			l1.pop_front();
+		}
+	}
+	l2 = l1;
+	l1.swap(l2);
+	l2.clear();
+	sum = 0;
+	while (!l1.empty())
+	{
+		sum += l1.back();
+		l1.pop_back();
+	}
+	std::cout << l1.size() << ", " << l2.size() << ", " << sum << std::endl;
+}
+
+// List pool splice test. Moves nodes between lists with pool allocators, and
+// destroys the list they came from before the list they went to.
+void	listPoolSplice()
+{
+	typedef ft::list<int, POOL_ALLOCATOR<int> >		pool_list;
+	pool_list										*source;
+	pool_list										*other;
+	pool_list										target;
+	long											sum;
+
+	source = new pool_list;
+	other = new pool_list;
+	for (int i = 0; i < 1000; i++)
+	{
+		source->push_back(i);
+		other->push_back(i * 2);
+	}
+	target.splice(target.begin(), *source);
+	delete source;
+	target.merge(*other);
+	delete other;
+	for (int i = 0; i < 1000; i++)
+		target.push_back(i);
+	sum = 0;
+	for (pool_list::iterator it = target.begin(); it != target.end(); it++)
+		sum += *it;
+	std::cout << target.size() << ", " << sum << ", " << target.front() << ", "
+		<< target.back() << std::endl;
+}
+
+// Map bound queries benchmark. Fills a map with random keys, then runs a lot of
+// random lower_bound, upper_bound and equal_range queries on it. The checksum
+// makes sure both implementations found the same elements.
+void	mapBoundQueries()
+{
+	ft::map<int, int>											m1;
+	ft::map<int, int>::iterator									it;
+	ft::pair<ft::map<int, int>::iterator, ft::map<int, int>::iterator>	range;
+	long														checksum;
+	int															key;
+
+	for (int i = 0; i < 100000; i++)
+		m1[rand()] = i;
+	checksum = 0;
+	for (int i = 0; i < 100000; i++)
+	{
+		key = rand();
+		it = m1.lower_bound(key);
+		if (it != m1.end())
+			checksum += it->second;
+		it = m1.upper_bound(key);
+		if (it != m1.end())
+			checksum -= it->second;
+		range = m1.equal_range(key);
+		if (range.first != range.second)
+			checksum += range.first->second;
+	}
+	std::cout << "Checksum: " << checksum << std::endl;
+}
+
+// A key compare that ignores case. Keys that only differ in case are the same
+// key to a map, even though == says they differ.
+struct	CaseInsensitiveLess
+{
+	bool	operator() (const std::string &x, const std::string &y) const
+	{
+		size_t	i;
+
+		for (i = 0; i < x.size() && i < y.size(); i++)
+		{
+			if (tolower(x[i]) != tolower(y[i]))
+				return (tolower(x[i]) < tolower(y[i]));
+		}
+		return (x.size() < y.size());
+	}
+};
+
+// A key that can only be ordered, not compared with ==.
+struct	OrderedKey
+{
+	int		value;
+};
+
+bool	operator<(const OrderedKey &x, const OrderedKey &y)
+{
+	return (x.value < y.value);
+}
+
+// Map key compare test. Keys are only compared with the key compare, so a
+// compare that ignores case makes "Apple" and "APPLE" the same key, and a key
+// type without == works.
+void	mapKeyCompare()
+{
+	ft::map<std::string, int, CaseInsensitiveLess>				words;
+	ft::map<std::string, int, CaseInsensitiveLess>::iterator	it;
+	ft::map<OrderedKey, int>									ordered;
+	OrderedKey													key;
+	long														sum;
+
+	words["apple"] = 1;
+	words["Pear"] = 2;
+	words["APPLE"] += 10;
+	std::cout << words.insert(ft::make_pair(std::string("PEAR"), 3)).second << ", "
+		<< words.size() << ", " << words.count("ApPlE") << ", " << words.find("pear")->second
+		<< ", " << (words.find("plum") == words.end()) << std::endl;
+	std::cout << words.erase("PEAR") << ", " << words.erase("pear") << ", " << words.size() << std::endl;
+	for (it = words.begin(); it != words.end(); it++)
+		std::cout << "[" << it->first << "," << it->second << "]";
+	std::cout << std::endl;
+
+	for (int i = 0; i < 10000; i++)
+	{
+		key.value = rand() % 2000;
+		ordered[key] += i;
+	}
+	for (int i = 0; i < 2000; i += 3)
+	{
+		key.value = i;
+		ordered.erase(key);
+	}
+	sum = 0;
+	for (int i = 0; i < 2000; i++)
+	{
+		key.value = i;
+		if (ordered.count(key))
+			sum += ordered.find(key)->second + ordered.lower_bound(key)->first.value;
+	}
+	std::cout << ordered.size() << ", " << sum << std::endl;
+}
+
+// A compare with state: it orders either up or down.
+struct	DirectedLess
+{
+	DirectedLess(bool down = false) : descending(down)
+	{
+	}
+	bool	operator() (int x, int y) const
+	{
+		return (descending ? y < x : x < y);
+	}
+
+	bool	descending;
+};
+
+// Map stateful compare test. A swapped or assigned map keeps ordering its
+// elements with the compare they came with.
+void	mapStatefulCompare()
+{
+	typedef ft::map<int, int, DirectedLess>		directed_map;
+	directed_map								up((DirectedLess(false)));
+	directed_map								down((DirectedLess(true)));
+	directed_map::iterator						it;
+
+	for (int i = 0; i < 6; i++)
+	{
+		up[i * 2] = i;
+		down[i * 3] = i;
+	}
+	up.swap(down);
+	for (int i = 0; i < 6; i++)
+	{
+		up[i * 5] = i;
+		down[i * 7] = i;
+	}
+	for (it = up.begin(); it != up.end(); it++)
+		std::cout << "[" << it->first << "," << it->second << "]";
+	std::cout << std::endl;
+	for (it = down.begin(); it != down.end(); it++)
+		std::cout << "[" << it->first << "," << it->second << "]";
+	std::cout << std::endl;
+	std::cout << up.key_comp().descending << ", " << down.key_comp().descending << ", "
+		<< up.value_comp()(ft::make_pair(1, 0), ft::make_pair(2, 0)) << std::endl;
+	down = up;
+	std::cout << down.key_comp().descending << ", "
+		<< down.value_comp()(ft::make_pair(1, 0), ft::make_pair(2, 0)) << ", "
+		<< down.begin()->first << std::endl;
+}
+
+// The order statistics of a map. The std version has no sizes in its nodes,
+// so it walks the elements instead.
+template <class Map>
+typename Map::iterator	nthOf(Map &m, size_t n)
+{
+#ifdef USE_STD
+	typename Map::iterator	it = m.begin();
+
+	while (n-- > 0 && it != m.end())
+		it++;
+	return it;
+#else
+	return m.nth(n);
+#endif
+}
+template <class Map>
+size_t	rankOf(Map &m, const typename Map::key_type &k)
+{
+#ifdef USE_STD
+	size_t	rank = 0;
+
+	for (typename Map::iterator it = m.begin(); it != m.lower_bound(k); it++)
+		rank++;
+	return rank;
+#else
+	return m.rank(k);
+#endif
+}
+template <class Map>
+long	distanceOf(Map &m, typename Map::iterator first, typename Map::iterator last)
+{
+#ifdef USE_STD
+	long	distance = 0;
+
+	(void)m;
+	while (first != last)
+	{
+		first++;
+		distance++;
+	}
+	return distance;
+#else
+	return m.distance(first, last);
+#endif
+}
+
+// Map order statistics test. Keeps a sliding window of samples in a map, and
+// looks up the median and the 99th percentile after every new sample. The
+// keys have the sample number in their low digits, so they are unique.
+void	mapOrderStatistics()
 {
-	Logger				logger;
+	RANK_MAP(long, int)		window;
+	long					keys[1000];
+	long					sum;
+	bool					consistent;
+	size_t					n;
 
+	sum = 0;
+	consistent = true;
+	for (int i = 0; i < 10000; i++)
+	{
+		if (i >= 1000)
+			window.erase(keys[i % 1000]);
+		keys[i % 1000] = static_cast<long>(rand() % 100000) * 1000000 + i;
+		window[keys[i % 1000]] = i;
+		n = window.size();
+		sum += nthOf(window, n / 2)->first / 1000000 + nthOf(window, n * 99 / 100)->first / 1000000;
+		if (i % 97 == 0)
+		{
+			consistent = consistent && rankOf(window, nthOf(window, n / 3)->first) == n / 3
+				&& rankOf(window, keys[i % 1000]) == rankOf(window, keys[i % 1000] - 1)
+				&& distanceOf(window, nthOf(window, n / 4), nthOf(window, n / 2)) == static_cast<long>(n / 2 - n / 4)
+				&& distanceOf(window, window.begin(), window.end()) == static_cast<long>(n);
+		}
+	}
+	std::cout << window.size() << ", " << sum << ", " << consistent << std::endl;
+	std::cout << (nthOf(window, window.size()) == window.end()) << ", " << rankOf(window, -1) << ", "
+		<< rankOf(window, 1000000000000L) << std::endl;
+	window.clear();
+	for (int i = 0; i < 100; i++)
+		window[i] = i;
+	std::cout << nthOf(window, 42)->second << ", " << rankOf(window, 42) << ", "
+		<< distanceOf(window, window.find(10), window.find(90)) << std::endl;
+}
+
+// Interval map test. Stores time ranges, and checks overlap and stabbing
+// queries after random inserts and erases.
+void	intervalMap()
+{
+	typedef INTERVAL_MAP(int, int)		interval_map;
+	interval_map						ranges;
+	ft::vector<interval_map::iterator>	found;
+	interval_map::iterator				it;
+	long								sum;
+	int									start;
+
+	ranges.insert(10, 20, 1);
+	ranges.insert(15, 25, 2);
+	ranges.insert(30, 40, 3);
+	ranges.insert(10, 12, 4);
+	ranges.insert(50, 50, 5);
+	std::cout << ranges.insert(15, 25, 6).second << ", " << ranges.size() << std::endl;
+	ranges.overlaps(18, 31, std::back_inserter(found));
+	for (size_t i = 0; i < found.size(); i++)
+		std::cout << "[" << found[i]->first.first << "-" << found[i]->first.second << ","
+			<< found[i]->second << "]";
+	std::cout << std::endl;
+	found.clear();
+	ranges.stab(50, std::back_inserter(found));
+	ranges.stab(11, std::back_inserter(found));
+	ranges.stab(26, std::back_inserter(found));
+	for (size_t i = 0; i < found.size(); i++)
+		std::cout << "[" << found[i]->first.first << "-" << found[i]->first.second << "]";
+	std::cout << std::endl;
+	it = ranges.first_overlap(21, 29);
+	std::cout << it->second << ", " << (ranges.first_overlap(41, 49) == ranges.end()) << std::endl;
+
+	sum = 0;
+	for (int i = 0; i < 20000; i++)
+	{
+		start = rand() % 100000;
+		if (i % 3 == 0)
+		{
+			it = ranges.first_overlap(start, start + 100);
+			if (it != ranges.end())
+				ranges.erase(it);
+		}
+		else
+			ranges.insert(start, start + rand() % 1000, i);
+		if (i % 100 == 0)
+		{
+			found.clear();
+			ranges.overlaps(start, start + rand() % 500, std::back_inserter(found));
+			for (size_t j = 0; j < found.size(); j++)
+				sum += found[j]->second;
+		}
+	}
+	std::cout << ranges.size() << ", " << sum << std::endl;
+}
+
+// Interval map stateful compare test. The points are ordered down, so an
+// interval starts at its highest point. The order of the intervals differs
+// from the std version, so it only prints counts and sums.
+void	intervalMapStatefulCompare()
+{
+	typedef COMPARED_INTERVAL_MAP(int, int, DirectedLess)	interval_map;
+	interval_map											ranges((DirectedLess(true)));
+	ft::vector<interval_map::iterator>						found;
+	long													sum;
+	int														start;
+
+	for (int i = 0; i < 2000; i++)
+	{
+		start = rand() % 100000;
+		ranges.insert(start, start - rand() % 1000, i);
+	}
+	sum = 0;
+	for (int i = 0; i < 200; i++)
+	{
+		start = rand() % 100000;
+		found.clear();
+		ranges.overlaps(start, start - rand() % 500, std::back_inserter(found));
+		ranges.stab(start, std::back_inserter(found));
+		for (size_t j = 0; j < found.size(); j++)
+			sum += found[j]->second;
+		sum += (ranges.first_overlap(start, start - 10) != ranges.end());
+	}
+	std::cout << ranges.size() << ", " << sum << std::endl;
+}
+
+// What the reader thread of the persistent map test works with: a snapshot,
+// and the sum it should find in it every time it reads it.
+struct SnapshotReader
+{
+	PERSISTENT_MAP(int, long)	snapshot;
+	long						expected;
+	int							matches;
+};
+
+// Reads the snapshot over and over, while the main thread changes the map it
+// was taken from.
+void	*snapshotReader(void *arg)
+{
+	SnapshotReader	*reader = static_cast<SnapshotReader *>(arg);
+	long			sum;
+
+	for (int i = 0; i < 200; i++)
+	{
+		sum = 0;
+		for (PERSISTENT_MAP(int, long)::const_iterator it = reader->snapshot.begin();
+				it != reader->snapshot.end(); it++)
+			sum += it->first * it->second;
+		reader->matches += (sum == reader->expected);
+		if (i % 10 == 0)
+			sched_yield();
+	}
+	return NULL;
+}
+
+// Sums key times value over a map.
+template <class Map>
+long	weightedSum(const Map &m)
+{
+	long	sum;
+
+	sum = 0;
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); it++)
+		sum += it->first * it->second;
+	return sum;
+}
+
+// Persistent map test. Snapshots keep what the map held when they were taken,
+// while the map itself keeps changing, also when a thread reads them.
+void	persistentMap()
+{
+	typedef PERSISTENT_MAP(int, long)	persistent_map;
+	persistent_map						values;
+	persistent_map						first;
+	persistent_map						second;
+	SnapshotReader						reader;
+	pthread_t							thread;
+	int									key;
+	bool								inserted;
+
+	for (int i = 0; i < 1000; i++)
+		values.insert(ft::make_pair(i, static_cast<long>(i)));
+	first = values.snapshot();
+	for (int i = 0; i < 1000; i += 2)
+		values.erase(i);
+	for (int i = 1; i < 1000; i += 4)
+		values.insert_or_assign(i, 0);
+	inserted = values.insert_or_assign(1000, 5).second;
+	std::cout << inserted << ", ";
+	inserted = values.insert_or_assign(1000, 6).second;
+	std::cout << inserted << std::endl;
+	second = values.snapshot();
+	values.clear();
+	std::cout << first.size() << ", " << weightedSum(first) << ", "
+		<< second.size() << ", " << weightedSum(second) << ", " << values.size() << std::endl;
+	std::cout << (first.find(2) != first.end()) << ", " << (second.find(2) != second.end())
+		<< ", " << second.find(1001 - 2)->second << std::endl;
+
+	for (int i = 0; i < 5000; i++)
+		values.insert(ft::make_pair(rand() % 20000, static_cast<long>(i)));
+	reader.snapshot = values.snapshot();
+	reader.expected = weightedSum(values);
+	reader.matches = 0;
+	pthread_create(&thread, NULL, snapshotReader, &reader);
+	for (int i = 0; i < 100000; i++)
+	{
+		key = rand() % 20000;
+		if (i % 3 == 0)
+			values.erase(key);
+		else
+			values.insert_or_assign(key, i);
+	}
+	pthread_join(thread, NULL);
+	std::cout << reader.snapshot.size() << ", " << reader.matches << ", "
+		<< values.size() << ", " << weightedSum(values) << std::endl;
+}
+
+// Vector growth test. Grows vectors of trivially copyable elements, which can
+// be moved as raw memory, and of strings, which have to be copied one by one.
+void	vectorGrowth()
+{
+	ft::vector<long>			vec1;
+	ft::vector<std::string>		vec2;
+	long						sum;
+
+	for (long i = 0; i < 4000000; i++)
+		vec1.push_back(i);
+	for (int i = 0; i < 100000; i++)
+		vec2.push_back(std::string(i % 50, 'a' + i % 26));
+	vec1.reserve(vec1.size() * 3);
+	vec2.reserve(vec2.size() * 3);
+	sum = 0;
+	for (size_t i = 0; i < vec1.size(); i += 1000)
+		sum += vec1[i];
+	for (size_t i = 0; i < vec2.size(); i += 1000)
+		sum += vec2[i].size();
+	std::cout << vec1.size() << ", " << vec2.size() << ", " << sum << std::endl;
+	std::cout << vec2[99999] << std::endl;
+}
+
+// Vector middle insert test. Keeps a vector sorted by inserting every value at
+// its place, like a sorted index would, then erases half of it again.
+void	vectorMiddleInsert()
+{
+	ft::vector<int>					vec1;
+	ft::vector<std::string>			vec2;
+	size_t							low;
+	size_t							high;
+	long							sum;
+	int								value;
+
+	for (int i = 0; i < 50000; i++)
+	{
+		value = rand() % 1000000;
+		low = 0;
+		high = vec1.size();
+		while (low < high)
+		{
+			if (vec1[(low + high) / 2] < value)
+				low = (low + high) / 2 + 1;
+			else
+				high = (low + high) / 2;
+		}
+		vec1.insert(vec1.begin() + low, value);
+	}
+	vec1.insert(vec1.begin(), 3, -1);
+	vec1.insert(vec1.begin() + 10, vec1.end() - 5, vec1.end());
+	for (size_t i = 0; i < vec1.size(); i += 2)
+		vec1.erase(vec1.begin() + i);
+	vec1.erase(vec1.begin(), vec1.begin() + 100);
+	sum = 0;
+	for (size_t i = 0; i < vec1.size(); i++)
+		sum += vec1[i] * (i % 7);
+	std::cout << vec1.size() << ", " << sum << std::endl;
+	for (int i = 0; i < 200; i++)
+		vec2.insert(vec2.begin() + vec2.size() / 3, std::string(i % 30, 'a' + i % 26));
+	vec2.insert(vec2.begin(), "first");
+	vec2.erase(vec2.begin() + 1);
+	vec2.erase(vec2.begin() + 50, vec2.begin() + 150);
+	for (size_t i = 0; i < vec2.size(); i += 10)
+		std::cout << "[" << vec2[i] << "]";
+	std::cout << std::endl;
+}
+
+// Shrinks the capacity of a vector to its size. C++98 has no shrink_to_fit, so
+// the std version uses the copy and swap trick.
+template <class Vector>
+void	shrinkToFit(Vector &vec)
+{
+#ifdef USE_STD
+	Vector(vec).swap(vec);
+#else
+	vec.shrink_to_fit();
+#endif
+}
+
+// Prints the contents of a vector with a custom growth policy, and checks that
+// the capacity stays in line with the size.
+template <class Vector>
+void	checkGrowth(Vector &vec)
+{
+	long	sum;
+
+	for (int i = 0; i < 100000; i++)
+		vec.push_back(i);
+	vec.insert(vec.begin() + 10, 1000, -1);
+	vec.resize(50000);
+	std::cout << vec.size() << ", " << (vec.capacity() >= vec.size());
+	shrinkToFit(vec);
+	std::cout << ", " << (vec.capacity() == vec.size());
+	vec.resize(10);
+	vec.push_back(42);
+	sum = 0;
+	for (size_t i = 0; i < vec.size(); i++)
+		sum += vec[i];
+	std::cout << ", " << sum << std::endl;
+	vec.clear();
+	shrinkToFit(vec);
+	std::cout << vec.size() << ", " << vec.capacity() << std::endl;
+}
+
+// Vector growth policy tests. Runs the same operations with every policy.
+void	vectorGrowthPolicies()
+{
+	GROWTH_VECTOR(int, double_growth)			vec1;
+	GROWTH_VECTOR(int, half_growth)				vec2;
+	GROWTH_VECTOR(int, page_growth<>)			vec3;
+	GROWTH_VECTOR(std::string, half_growth)		vec4;
+
+	checkGrowth(vec1);
+	checkGrowth(vec2);
+	checkGrowth(vec3);
+	for (int i = 0; i < 1000; i++)
+		vec4.push_back(std::string(i % 20, 'a' + i % 26));
+	vec4.resize(500);
+	shrinkToFit(vec4);
+	std::cout << vec4.size() << ", " << (vec4.capacity() == vec4.size()) << ", " << vec4[499] << std::endl;
+}
+
+// Prints the contents of a list.
+template <class T>
+void	printList(ft::list<T> &lst)
+{
+	typename ft::list<T>::iterator	it;
+
+	std::cout << "List size: " << lst.size() << std::endl;
+	for (it = lst.begin(); it != lst.end(); it++)
+		std::cout << "[" << *it << "]";
+	std::cout << std::endl;
+}
+
+// List positional operations test. Uses a big list as an LRU cache, where
+// every touched entry is spliced to the front and the back gets evicted.
+void	listPositional()
+{
+	ft::vector<int>								values;
+	ft::vector<ft::list<int>::iterator>			entries;
+	ft::list<int>								lru;
+	ft::list<int>								other;
+	ft::list<int>::iterator						it;
+	ft::list<int>::iterator						last;
+	long										sum;
+	size_t										index;
+
+	for (int i = 0; i < 10; i++)
+		values.push_back(i * 3);
+	ft::list<int>		lst(values.begin(), values.end());
+	it = lst.begin();
+	for (int i = 0; i < 4; i++)
+		it++;
+	lst.insert(it, 100);
+	lst.insert(it, 2, 200);
+	lst.insert(it, values.begin(), values.begin() + 3);
+	it = lst.erase(it);
+	last = it;
+	last++;
+	last++;
+	it = lst.erase(it, last);
+	other.splice(other.begin(), lst, lst.begin(), it);
+	other.splice(other.end(), lst, --lst.end());
+	lst.splice(lst.begin(), lst, --lst.end(), lst.end());
+	printList(lst);
+	printList(other);
+
+	for (int i = 0; i < 200000; i++)
+		entries.push_back(lru.insert(lru.end(), i));
+	sum = 0;
+	for (int i = 0; i < 200000; i++)
+	{
+		index = rand() % entries.size();
+		lru.splice(lru.begin(), lru, entries[index]);
+		sum += *lru.begin() - lru.back();
+		if (i % 4 == 0)
+			lru.insert(lru.begin(), -i);
+	}
+	while (lru.size() > 100000)
+		lru.erase(--lru.end());
+	std::cout << lru.size() << ", " << sum << ", " << lru.front() << ", " << lru.back() << std::endl;
+}
+
+// Compares only the first value of a pair, to check that sorting is stable.
+bool	compareFirst(ft::pair<int, int> const &lhs, ft::pair<int, int> const &rhs)
+{
+	return lhs.first < rhs.first;
+}
+
+// List sort tests. Sorts a big random list, and checks that elements that
+// compare equal keep their order.
+void	listSort()
+{
+	ft::list<int>						lst;
+	ft::list<ft::pair<int, int> >		pairs;
+	ft::list<int>::iterator				it;
+	ft::list<ft::pair<int, int> >::iterator		pit;
+	long								sum;
+	int									prev;
+	bool								sorted;
+
+	lst.sort();
+	lst.push_back(1);
+	lst.sort();
+	for (int i = 0; i < 500000; i++)
+		lst.push_back(rand() % 100000);
+	lst.sort();
+	sorted = true;
+	prev = lst.front();
+	sum = 0;
+	for (it = lst.begin(); it != lst.end(); it++)
+	{
+		sorted = sorted && prev <= *it;
+		prev = *it;
+		sum += *it;
+	}
+	std::cout << lst.size() << ", " << sorted << ", " << sum << std::endl;
+	it = lst.end();
+	it--;
+	std::cout << lst.front() << ", " << *it << ", " << lst.back() << std::endl;
+	for (int i = 0; i < 40; i++)
+		pairs.push_back(ft::make_pair(rand() % 5, i));
+	pairs.sort(compareFirst);
+	for (pit = pairs.begin(); pit != pairs.end(); pit++)
+		std::cout << "[" << pit->first << "," << pit->second << "]";
+	std::cout << std::endl;
+	for (pit = --pairs.end(); pit != pairs.begin(); pit--)
+		std::cout << "[" << pit->second << "]";
+	std::cout << std::endl;
+}
+
+// Used to merge lists that are sorted in descending order.
+bool	isGreater(int lhs, int rhs)
+{
+	return lhs > rhs;
+}
+
+// List reverse and merge tests.
+void	listReverseMerge()
+{
+	ft::list<int>		lst1;
+	ft::list<int>		lst2;
+	ft::list<int>		lst3;
+	long				sum;
+
+	lst1.reverse();
+	printList(lst1);
+	for (int i = 0; i < 10; i++)
+		lst1.push_back(i);
+	lst1.reverse();
+	printList(lst1);
+	lst1.reverse();
+	for (int i = 0; i < 10; i += 3)
+		lst2.push_back(i);
+	for (int i = 15; i < 20; i++)
+		lst2.push_back(i);
+	lst1.merge(lst2);
+	printList(lst1);
+	printList(lst2);
+	lst2.push_back(-1);
+	lst1.merge(lst2);
+	lst1.merge(lst3);
+	lst1.merge(lst1);
+	printList(lst1);
+	lst3.merge(lst1);
+	lst3.reverse();
+	lst3.merge(lst1, isGreater);
+	printList(lst3);
+	for (int i = 0; i < 1000000; i++)
+		lst1.push_back(i * 2);
+	for (int i = 0; i < 1000000; i++)
+		lst2.push_back(i * 3);
+	lst1.merge(lst2);
+	lst1.reverse();
+	sum = 0;
+	for (int i = 0; i < 1000; i++)
+	{
+		sum += static_cast<long>(lst1.front()) * i;
+		lst1.pop_front();
+	}
+	std::cout << lst1.size() << ", " << lst2.size() << ", " << sum << ", " << lst1.back() << std::endl;
+}
+
+// Prints the contents of a deque.
+template <class T>
+void	printDeque(ft::deque<T> &dq)
+{
+	typename ft::deque<T>::iterator		it;
+
+	std::cout << "Deque size: " << dq.size() << std::endl;
+	for (it = dq.begin(); it != dq.end(); it++)
+		std::cout << "[" << *it << "]";
+	std::cout << std::endl;
+}
+
+// Some basic deque tests. Pushing and popping at both ends, access by index,
+// inserting and erasing, and the iterators.
+void	dequeBasics()
+{
+	ft::deque<int>						dq1;
+	ft::deque<int>						dq2(5, 42);
+	ft::deque<std::string>				dq3;
+	ft::deque<int>::iterator			it;
+	ft::deque<int>::reverse_iterator	rit;
+
+	for (int i = 0; i < 10; i++)
+	{
+		dq1.push_back(i);
+		dq1.push_front(-i);
+	}
+	printDeque(dq1);
+	dq1.pop_back();
+	dq1.pop_front();
+	std::cout << dq1.front() << ", " << dq1.back() << ", " << dq1[5] << ", " << dq1.at(17) << std::endl;
+	try
+	{
+		dq1.at(18);
+	}
+	catch (std::out_of_range &e)
+	{
+		std::cout << "Out of range" << std::endl;
+	}
+	it = dq1.insert(dq1.begin() + 3, 100);
+	std::cout << *it << std::endl;
+	dq1.insert(dq1.end() - 2, 3, 200);
+	dq1.insert(dq1.begin() + 1, dq2.begin(), dq2.end());
+	printDeque(dq1);
+	it = dq1.erase(dq1.begin() + 4);
+	std::cout << *it << std::endl;
+	dq1.erase(dq1.begin() + 10, dq1.end() - 3);
+	printDeque(dq1);
+	for (rit = dq1.rbegin(); rit != dq1.rend(); rit++)
+		std::cout << "[" << *rit << "]";
+	std::cout << std::endl;
+	it = dq1.begin() + 6;
+	std::cout << *(it - 4) << ", " << it[2] << ", " << (dq1.end() - it) << ", " << (it < dq1.end()) << std::endl;
+	dq2.swap(dq1);
+	dq1.resize(8, 7);
+	printDeque(dq1);
+	std::cout << (dq1 == dq2) << ", " << (dq1 < dq2) << ", " << dq2.size() << std::endl;
+	dq1 = dq2;
+	std::cout << (dq1 == dq2) << std::endl;
+	dq1.clear();
+	std::cout << dq1.empty() << ", " << dq1.size() << std::endl;
+	for (int i = 0; i < 5000; i++)
+		dq3.push_front(std::string(i % 10, 'a' + i % 26));
+	dq3.erase(dq3.begin() + 100, dq3.begin() + 4900);
+	std::cout << dq3.size() << ", " << dq3[50] << ", " << dq3[150] << std::endl;
+}
+
+// Queue test. The queue is used for bursts of jobs, where a lot of items are
+// pushed and then drained again.
+void	queueBursts()
+{
+	ft::queue<int>		q1;
+	ft::queue<int>		q2;
+	long				sum;
+
+	sum = 0;
+	for (int burst = 0; burst < 10; burst++)
+	{
+		for (int i = 0; i < 1000000; i++)
+			q1.push(burst + i);
+		while (q1.size() > 1000)
+		{
+			sum += q1.front();
+			q1.pop();
+		}
+	}
+	q2 = q1;
+	std::cout << q1.size() << ", " << sum << ", " << q1.front() << ", " << q1.back() << std::endl;
+	std::cout << (q1 == q2) << ", " << (q1 < q2) << std::endl;
+	q2.pop();
+	std::cout << (q1 == q2) << ", " << (q1 < q2) << std::endl;
+}
+
+// The amount of messages that go through the queue in the SPSC queue test.
+static const long	spscMessages = 2000000;
+
+// The producer of the SPSC queue test. Sends the numbers in order, one by one
+// and in batches.
+void	*spscProducer(void *arg)
+{
+	SPSC_QUEUE<long, 1024>	*queue = static_cast<SPSC_QUEUE<long, 1024> *>(arg);
+	long					batch[64];
+	long					next;
+	size_t					pushed;
+
+	next = 0;
+	while (next < spscMessages)
+	{
+		if (next % 2048 < 1024)
+		{
+			if (queue->try_push(next))
+				next++;
+			else
+				sched_yield();
+			continue ;
+		}
+		for (int i = 0; i < 64; i++)
+			batch[i] = next + i;
+		pushed = queue->push_n(batch, 64);
+		if (pushed == 0)
+			sched_yield();
+		next += pushed;
+	}
+	return NULL;
+}
+
+// SPSC queue test. One thread produces, the main thread consumes and checks
+// that everything arrives once and in order.
+void	spscQueue()
+{
+	SPSC_QUEUE<long, 1024>	queue;
+	pthread_t				producer;
+	long					batch[100];
+	long					expected;
+	long					sum;
+	bool					inOrder;
+	size_t					popped;
+
+	expected = 0;
+	sum = 0;
+	inOrder = true;
+	pthread_create(&producer, NULL, spscProducer, &queue);
+	while (expected < spscMessages)
+	{
+		if (expected % 3 == 0)
+			popped = queue.pop_n(batch, 100);
+		else
+			popped = queue.try_pop(batch[0]);
+		if (popped == 0)
+			sched_yield();
+		for (size_t i = 0; i < popped; i++)
+		{
+			inOrder = inOrder && batch[i] == expected;
+			sum += batch[i];
+			expected++;
+		}
+	}
+	pthread_join(producer, NULL);
+	std::cout << expected << ", " << sum << ", " << inOrder << ", " << queue.empty() << std::endl;
+}
+
+// The amount of messages every producer sends in the MPMC queue test.
+static const long	mpmcMessages = 60000;
+
+// What a thread of the MPMC queue test works with. Producers send their id
+// times the message count plus a counter, so consumers can tell who sent a
+// message and check that the messages of one producer arrive in order.
+template <class Queue>
+struct	MpmcThread
+{
+	Queue	*queue;
+	long	id;
+	long	producers;
+	long	count;
+	long	sum;
+	bool	inOrder;
+};
+
+// A producer of the MPMC queue test. Even producers use the blocking push,
+// odd ones keep trying.
+template <class Queue>
+void	*mpmcProducer(void *arg)
+{
+	MpmcThread<Queue>	*thread = static_cast<MpmcThread<Queue> *>(arg);
+	long				base = thread->id * mpmcMessages;
+
+	for (long i = 0; i < thread->count; i++)
+	{
+		if (thread->id % 2 == 0)
+			thread->queue->push(base + i);
+		else
+			while (!thread->queue->try_push(base + i))
+				sched_yield();
+	}
+	return NULL;
+}
+
+// A consumer of the MPMC queue test. Even consumers use the blocking pop,
+// odd ones keep trying.
+template <class Queue>
+void	*mpmcConsumer(void *arg)
+{
+	MpmcThread<Queue>	*thread = static_cast<MpmcThread<Queue> *>(arg);
+	long				last[8];
+	long				val;
+
+	for (long p = 0; p < thread->producers; p++)
+		last[p] = -1;
+	thread->sum = 0;
+	thread->inOrder = true;
+	for (long i = 0; i < thread->count; i++)
+	{
+		if (thread->id % 2 == 0)
+			thread->queue->pop(val);
+		else
+			while (!thread->queue->try_pop(val))
+				sched_yield();
+		thread->inOrder = thread->inOrder && val % mpmcMessages > last[val / mpmcMessages];
+		last[val / mpmcMessages] = val % mpmcMessages;
+		thread->sum += val;
+	}
+	return NULL;
+}
+
+// Runs the producers and consumers of the MPMC queue test on one queue, and
+// prints what the consumers got all together.
+template <class Queue>
+void	mpmcRun(long producers, long consumers)
+{
+	Queue				queue;
+	pthread_t			threads[16];
+	MpmcThread<Queue>	args[16];
+	long				count;
+	long				sum;
+	bool				inOrder;
+
+	for (long i = 0; i < producers + consumers; i++)
+	{
+		args[i].queue = &queue;
+		args[i].id = (i < producers) ? i : i - producers;
+		args[i].producers = producers;
+		args[i].count = (i < producers) ? mpmcMessages : mpmcMessages * producers / consumers;
+		pthread_create(&threads[i], NULL,
+			(i < producers) ? mpmcProducer<Queue> : mpmcConsumer<Queue>, &args[i]);
+	}
+	count = 0;
+	sum = 0;
+	inOrder = true;
+	for (long i = 0; i < producers + consumers; i++)
+	{
+		pthread_join(threads[i], NULL);
+		if (i < producers)
+			continue ;
+		count += args[i].count;
+		sum += args[i].sum;
+		inOrder = inOrder && args[i].inOrder;
+	}
+	std::cout << producers << " to " << consumers << ": " << count << ", " << sum
+		<< ", " << inOrder << ", " << queue.empty() << std::endl;
+}
+
+// MPMC queue test. First checks the queue on one thread, then sends messages
+// through it with different amounts of producers and consumers.
+void	mpmcQueue()
+{
+	MPMC_QUEUE(long, 8)		small;
+	long					val;
+
+	std::cout << small.capacity() << ", " << small.empty() << std::endl;
+	for (long i = 0; i < 9; i++)
+		std::cout << small.try_push(i) << " ";
+	std::cout << small.size() << std::endl;
+	for (long i = 0; i < 4; i++)
+	{
+		small.pop(val);
+		std::cout << val << " ";
+	}
+	for (long i = 20; i < 24; i++)
+		small.push(i);
+	while (small.try_pop(val))
+		std::cout << val << " ";
+	std::cout << small.empty() << std::endl;
+
+	mpmcRun<MPMC_QUEUE(long, 64)>(1, 1);
+	mpmcRun<MPMC_QUEUE(long, 64)>(2, 2);
+	mpmcRun<MPMC_QUEUE(long, 64)>(4, 1);
+	mpmcRun<MPMC_QUEUE(long, 64)>(1, 4);
+	mpmcRun<MPMC_QUEUE(long, 16)>(4, 4);
+	mpmcRun<BLOCKING_MPMC_QUEUE(long, 64)>(2, 2);
+	mpmcRun<BLOCKING_MPMC_QUEUE(long, 16)>(4, 4);
+}
+
+// The amount of values every thread pushes in the lock-free stack test.
+static const long	lockfreeStackValues = 20000;
+
+// What a thread of the lock-free stack test works with.
+struct	LockfreeStackThread
+{
+	LOCKFREE_STACK<long>	*stack;
+	long					id;
+	long					popped;
+	long					sum;
+};
+
+// A thread of the lock-free stack test. Pushes its values in bursts and pops
+// as many as it pushed, so nodes keep moving between the threads.
+void	*lockfreeStackWorker(void *arg)
+{
+	LockfreeStackThread	*thread = static_cast<LockfreeStackThread *>(arg);
+	long				base = thread->id * lockfreeStackValues;
+	long				val;
+
+	thread->popped = 0;
+	thread->sum = 0;
+	for (long i = 0; i < lockfreeStackValues; i += 100)
+	{
+		for (long j = i; j < i + 100; j++)
+			thread->stack->push(base + j);
+		for (long j = 0; j < 100; j++)
+		{
+			while (!thread->stack->try_pop(val))
+				sched_yield();
+			thread->popped++;
+			thread->sum += val;
+		}
+	}
+	return NULL;
+}
+
+// Lock-free stack test. First checks the stack on one thread, then lets a lot
+// of threads push and pop at the same time.
+void	lockfreeStack()
+{
+	LOCKFREE_STACK<std::string>	words;
+	LOCKFREE_STACK<long>		numbers;
+	LockfreeStackThread			args[32];
+	pthread_t					threads[32];
+	std::string					word;
+	long						popped;
+	long						sum;
+
+	std::cout << words.empty() << ", " << words.try_pop(word) << std::endl;
+	words.push("one");
+	words.push("two");
+	words.push("three");
+	std::cout << words.top() << ", " << words.empty() << std::endl;
+	words.pop();
+	words.top() += "!";
+	while (words.try_pop(word))
+		std::cout << word << " ";
+	std::cout << words.empty() << std::endl;
+	words.push("left over");
+
+	for (long i = 0; i < 32; i++)
+	{
+		args[i].stack = &numbers;
+		args[i].id = i;
+		pthread_create(&threads[i], NULL, lockfreeStackWorker, &args[i]);
+	}
+	popped = 0;
+	sum = 0;
+	for (long i = 0; i < 32; i++)
+	{
+		pthread_join(threads[i], NULL);
+		popped += args[i].popped;
+		sum += args[i].sum;
+	}
+	std::cout << popped << ", " << sum << ", " << numbers.empty() << std::endl;
+}
+
+// Prints the contents of a flat map.
+template <class Map>
+void	printFlatMap(Map &m)
+{
+	typename Map::const_iterator	it;
+
+	std::cout << "Flat map size: " << m.size() << ", empty: " << m.empty() << std::endl;
+	for (it = m.begin(); it != m.end(); it++)
+		std::cout << "[" << it->first << "," << it->second << "]";
+	std::cout << std::endl;
+}
+
+// Flat map test. Builds a map in bulk and one element at a time, and checks
+// that lookups, erasing and iterating work like they do on a map.
+void	flatMap()
+{
+	FLAT_MAP<int, std::string>					m1;
+	FLAT_MAP<int, std::string>					m2;
+	FLAT_MAP<int, std::string>::iterator		it;
+	FLAT_MAP<int, std::string>::reverse_iterator	rit;
+	ft::pair<FLAT_MAP<int, std::string>::iterator, FLAT_MAP<int, std::string>::iterator>	range;
+	ft::vector<ft::pair<int, std::string> >	batch;
+	FLAT_MAP<int, long>						m3;
+	long									checksum;
+	int										key;
+
+	m1[5] = "five";
+	m1[1] = "one";
+	m1[3] = "three";
+	std::cout << m1.insert(ft::make_pair(3, std::string("drie"))).second << ", ";
+	std::cout << m1.insert(ft::make_pair(4, std::string("four"))).second << ", ";
+	it = m1.insert(m1.end(), ft::make_pair(9, std::string("nine")));
+	std::cout << it->second << ", ";
+	it = m1.insert(m1.begin(), ft::make_pair(7, std::string("seven")));
+	std::cout << it->second << std::endl;
+	printFlatMap(m1);
+
+	// Bulk insert with keys that are already there, and keys that are in
+	// the range twice.
+	batch.push_back(ft::make_pair(8, std::string("eight")));
+	batch.push_back(ft::make_pair(1, std::string("een")));
+	batch.push_back(ft::make_pair(2, std::string("two")));
+	batch.push_back(ft::make_pair(8, std::string("acht")));
+	batch.push_back(ft::make_pair(0, std::string("zero")));
+	batch.push_back(ft::make_pair(6, std::string("six")));
+	batch.push_back(ft::make_pair(2, std::string("twee")));
+	batch.push_back(ft::make_pair(10, std::string("ten")));
+	m1.insert(batch.begin(), batch.end());
+	printFlatMap(m1);
+
+	std::cout << m1.count(6) << ", " << m1.count(11) << ", " << (m1.find(11) == m1.end());
+	std::cout << ", " << m1.find(8)->second << ", " << m1.lower_bound(4)->second;
+	std::cout << ", " << m1.upper_bound(4)->second << std::endl;
+	range = m1.equal_range(6);
+	std::cout << range.first->second << ", " << range.second->second << std::endl;
+	range = m1.equal_range(20);
+	std::cout << (range.first == m1.end()) << ", " << (range.second == m1.end()) << std::endl;
+	for (rit = m1.rbegin(); rit != m1.rend(); rit++)
+		std::cout << rit->first;
+	std::cout << std::endl;
+
+	m1.find(2)->second = "TWO";
+	m1.erase(m1.begin());
+	std::cout << m1.erase(5) << ", " << m1.erase(5) << std::endl;
+	m1.erase(m1.find(7), m1.find(10));
+	printFlatMap(m1);
+
+	m2 = m1;
+	std::cout << (m1 == m2) << ", " << (m1 < m2) << ", ";
+	m2[4] = "vier";
+	std::cout << (m1 == m2) << ", " << (m1 < m2) << ", " << (m2 < m1) << std::endl;
+	m2.erase(10);
+	std::cout << (m1 < m2) << ", " << (m1 > m2) << std::endl;
+	m1.swap(m2);
+	printFlatMap(m1);
+	printFlatMap(m2);
+	m2.clear();
+	printFlatMap(m2);
+
+	// A big map, built one key at a time, and checked against bulk lookups.
+	for (int i = 0; i < 20000; i++)
+		m3[rand() % 100000] = i;
+	checksum = 0;
+	for (int i = 0; i < 100000; i++)
+	{
+		key = rand() % 100000;
+		if (m3.find(key) != m3.end())
+			checksum += m3[key];
+		if (m3.lower_bound(key) != m3.end())
+			checksum -= m3.lower_bound(key)->second;
+	}
+	std::cout << m3.size() << ", " << checksum << std::endl;
+}
+
+// Checks that a hash map keeps its load factor below the maximum, and that
+// reserving room means inserting doesn't grow the table. The std version,
+// which is a map, has no hash policy, so it always passes.
+template <class Map>
+void	checkHashPolicy(Map &m, int extra)
+{
+#ifdef USE_STD
+	for (int i = 0; i < extra; i++)
+		m[-1 - i];
+	std::cout << "true, true" << std::endl;
+#else
+	size_t	buckets;
+
+	m.reserve(m.size() + extra);
+	buckets = m.bucket_count();
+	for (int i = 0; i < extra; i++)
+		m[-1 - i];
+	std::cout << (m.load_factor() <= m.max_load_factor()) << ", "
+		<< (m.bucket_count() == buckets) << std::endl;
+#endif
+}
+
+// Unordered map test. The order of the elements differs from a map, so it
+// only prints sums, or copies the elements into a map first.
+void	unorderedMap()
+{
+	HASH_MAP(int, int)				m1;
+	HASH_MAP(int, int)				m2;
+	HASH_MAP(int, int)::iterator	it;
+	STRING_HASH_MAP(int)			words;
+	ft::map<int, int>				sorted;
+	ft::map<int, int>				reference;
+	long							sum;
+	bool							same;
+	int								key;
+
+	for (int i = 0; i < 100000; i++)
+		m1[i * 7] = i;
+	for (int i = 0; i < 100000; i += 2)
+		m1.erase(i * 7);
+	std::cout << m1.size() << ", " << m1.count(14) << ", " << m1.count(21) << ", "
+		<< (m1.find(20) == m1.end()) << ", " << m1.find(63)->second << std::endl;
+	sum = 0;
+	for (it = m1.begin(); it != m1.end(); it++)
+		sum += it->first - it->second;
+	std::cout << "Sum: " << sum << std::endl;
+	m1.erase(m1.find(7));
+	std::cout << m1.insert(ft::make_pair(7, 70)).second << ", "
+		<< m1.insert(ft::make_pair(7, 71)).second << ", " << m1[7] << std::endl;
+	checkHashPolicy(m1, 5000);
+
+	m2 = m1;
+	std::cout << (m1 == m2) << ", ";
+	m2[21] = 0;
+	std::cout << (m1 == m2) << ", ";
+	m1.swap(m2);
+	std::cout << m1[21] << ", " << m2[21] << std::endl;
+	m1.erase(m1.begin(), m1.end());
+	std::cout << m1.size() << ", " << m1.empty() << ", " << (m1.begin() == m1.end()) << std::endl;
+	m2.clear();
+	for (int i = 0; i < 10; i++)
+		m2[i * i] = i;
+	sorted.insert(m2.begin(), m2.end());
+	printMap(sorted);
+
+	words["apple"] = 1;
+	words["pear"] = 2;
+	words[std::string("plum")] = 3;
+	words["apple"] += 10;
+	std::cout << words.find("apple")->second << ", " << (words.find("kiwi") == words.end())
+		<< ", " << words.count("pear") << ", " << words.size() << std::endl;
+
+	// Random inserts and erases, checked against a map.
+	m1.clear();
+	for (int i = 0; i < 200000; i++)
+	{
+		key = rand() % 20000;
+		if (i % 3 == 0)
+		{
+			m1.erase(key);
+			reference.erase(key);
+		}
+		else
+		{
+			m1[key] = i;
+			reference[key] = i;
+		}
+	}
+	same = (m1.size() == reference.size());
+	for (ft::map<int, int>::iterator rit = reference.begin(); rit != reference.end(); rit++)
+		same = same && m1.count(rit->first) && m1[rit->first] == rit->second;
+	std::cout << m1.size() << ", " << same << std::endl;
+}
+
+// A hash function that sends every key to the same home.
+struct ConstantHash
+{
+	std::size_t	operator()(int) const
+	{
+		return 42;
+	}
+};
+
+// Unordered map collisions test. Every key has the same hash, so all of them
+// are in one long probe. The table should still only grow with the amount
+// of elements. The std version, which is a map, has no buckets, so it always
+// passes that check.
+void	unorderedMapCollisions()
+{
+	CONSTANT_HASH_MAP(int, int)		m;
+	long							sum;
+	bool							small;
+
+	for (int i = 0; i < 400; i++)
+		m[i * 3] = i;
+	for (int i = 0; i < 400; i += 4)
+		m.erase(i * 3);
+	std::cout << m.size() << ", " << m.count(3) << ", " << m.count(12) << ", "
+		<< (m.find(1) == m.end()) << ", " << m.find(1197)->second << std::endl;
+	for (int i = 0; i < 100; i++)
+		m.insert(ft::make_pair(-i, i));
+	sum = 0;
+	for (CONSTANT_HASH_MAP(int, int)::iterator it = m.begin(); it != m.end(); it++)
+		sum += it->first + it->second;
+#ifdef USE_STD
+	small = true;
+#else
+	small = (m.bucket_count() <= 4 * m.size());
+#endif
+	std::cout << m.size() << ", " << sum << ", " << small << std::endl;
+	m.clear();
+	std::cout << m.size() << ", " << (m.find(3) == m.end()) << std::endl;
+}
+
+// Flat hash map and set test. Like the unordered map test, it only prints
+// sums, or copies the elements into a map first. The erases leave deleted
+// slots behind, which inserts have to reuse or clean up.
+void	flatHashMapAndSet()
+{
+	FLAT_HASH_MAP(int, int)				m1;
+	FLAT_HASH_MAP(int, int)				m2;
+	FLAT_HASH_MAP(int, int)::iterator	it;
+	FLAT_HASH_SET(int)					s1;
+	FLAT_HASH_SET(int)::iterator		sit;
+	ft::map<int, int>					sorted;
+	ft::map<int, int>					reference;
+	long								sum;
+	bool								same;
+	int									key;
+
+	for (int i = 0; i < 100000; i++)
+		m1[i * 7] = i;
+	for (int i = 0; i < 100000; i += 2)
+		m1.erase(i * 7);
+	std::cout << m1.size() << ", " << m1.count(14) << ", " << m1.count(21) << ", "
+		<< (m1.find(20) == m1.end()) << ", " << m1.find(63)->second << std::endl;
+	sum = 0;
+	for (it = m1.begin(); it != m1.end(); it++)
+		sum += it->first - it->second;
+	std::cout << "Sum: " << sum << std::endl;
+	m1.erase(m1.find(7));
+	std::cout << m1.insert(ft::make_pair(7, 70)).second << ", "
+		<< m1.insert(ft::make_pair(7, 71)).second << ", " << m1[7] << std::endl;
+	checkHashPolicy(m1, 5000);
+
+	m2 = m1;
+	std::cout << (m1 == m2) << ", ";
+	m2[21] = 0;
+	std::cout << (m1 == m2) << ", ";
+	m1.swap(m2);
+	std::cout << m1[21] << ", " << m2[21] << std::endl;
+	m1.erase(m1.begin(), m1.end());
+	std::cout << m1.size() << ", " << m1.empty() << ", " << (m1.begin() == m1.end()) << std::endl;
+	m2.clear();
+	for (int i = 0; i < 10; i++)
+		m2[i * i] = i;
+	sorted.insert(m2.begin(), m2.end());
+	printMap(sorted);
+
+	// Random inserts and erases, checked against a map.
+	m1.clear();
+	for (int i = 0; i < 200000; i++)
+	{
+		key = rand() % 20000;
+		if (i % 3 == 0)
+		{
+			m1.erase(key);
+			reference.erase(key);
+		}
+		else
+		{
+			m1[key] = i;
+			reference[key] = i;
+		}
+	}
+	same = (m1.size() == reference.size());
+	for (ft::map<int, int>::iterator rit = reference.begin(); rit != reference.end(); rit++)
+		same = same && m1.count(rit->first) && m1[rit->first] == rit->second;
+	std::cout << m1.size() << ", " << same << std::endl;
+
+	for (int i = 0; i < 1000; i++)
+		s1.insert(i % 300);
+	for (int i = 0; i < 300; i += 3)
+		s1.erase(i);
+	sum = 0;
+	for (sit = s1.begin(); sit != s1.end(); sit++)
+		sum += *sit;
+	std::cout << s1.size() << ", " << s1.count(3) << ", " << s1.count(4) << ", " << sum << std::endl;
+	std::cout << s1.insert(4).second << ", ";
+	std::cout << s1.insert(3).second << ", " << s1.size() << std::endl;
+	s1.erase(s1.begin(), s1.end());
+	std::cout << s1.size() << ", " << (s1.begin() == s1.end()) << std::endl;
+}
+
+// This typedefs 'testFunction' as a function that takes and returns nothing.
+typedef void (*testFunction)(void);
+
+int main()
+{
 	// Uncomment this to check for leaks. Don't use this in the 'test' command
 	// for make.
 	//atexit(checkLeaks);
@@ -571,8 +2468,38 @@ int main()
 	tests["Stack basics"] = stackBasics;
 	tests["Stack relational operators"] = stackRelational;
 	tests["Map basics"] = mapBasics;
+	tests["Map iterators"] = mapIterators;
 	tests["Map relational operators"] = mapRelational;
 	tests["Map stress test"] = mapStressTest;
+	tests["Map hinted insert"] = mapHintedInsert;
+	tests["Map counters"] = mapCounters;
+	tests["Map bulk construction"] = mapBulkConstruction;
+	tests["Map bound queries"] = mapBoundQueries;
+	tests["Map key compare"] = mapKeyCompare;
+	tests["Map stateful compare"] = mapStatefulCompare;
+	tests["Map order statistics"] = mapOrderStatistics;
+	tests["Interval map"] = intervalMap;
+	tests["Interval map stateful compare"] = intervalMapStatefulCompare;
+	tests["Persistent map"] = persistentMap;
+	tests["Map pool allocator"] = mapPoolAllocator;
+	tests["Map clear"] = mapClear;
+	tests["List pool allocator"] = listPoolAllocator;
+	tests["List pool splice"] = listPoolSplice;
+	tests["Vector growth"] = vectorGrowth;
+	tests["Vector middle insert"] = vectorMiddleInsert;
+	tests["Vector growth policies"] = vectorGrowthPolicies;
+	tests["List positional operations"] = listPositional;
+	tests["List sort"] = listSort;
+	tests["List reverse and merge"] = listReverseMerge;
+	tests["Deque basics"] = dequeBasics;
+	tests["Queue bursts"] = queueBursts;
+	tests["SPSC queue"] = spscQueue;
+	tests["MPMC queue"] = mpmcQueue;
+	tests["Lock-free stack"] = lockfreeStack;
+	tests["Flat map"] = flatMap;
+	tests["Unordered map"] = unorderedMap;
+	tests["Unordered map collisions"] = unorderedMapCollisions;
+	tests["Flat hash map and set"] = flatHashMapAndSet;
 
 	// This vector of functions is used to iterate over the map and run the
 	// right testing functions.
@@ -586,15 +2513,45 @@ int main()
 	testNames.push_back("Stack basics");
 	testNames.push_back("Stack relational operators");
 	testNames.push_back("Map basics");
+	testNames.push_back("Map iterators");
 	testNames.push_back("Map relational operators");
 	testNames.push_back("Map stress test");
+	testNames.push_back("Map hinted insert");
+	testNames.push_back("Map counters");
+	testNames.push_back("Map bulk construction");
+	testNames.push_back("Map bound queries");
+	testNames.push_back("Map key compare");
+	testNames.push_back("Map stateful compare");
+	testNames.push_back("Map order statistics");
+	testNames.push_back("Interval map");
+	testNames.push_back("Interval map stateful compare");
+	testNames.push_back("Persistent map");
+	testNames.push_back("Map pool allocator");
+	testNames.push_back("Map clear");
+	testNames.push_back("List pool allocator");
+	testNames.push_back("List pool splice");
+	testNames.push_back("Vector growth");
+	testNames.push_back("Vector middle insert");
+	testNames.push_back("Vector growth policies");
+	testNames.push_back("List positional operations");
+	testNames.push_back("List sort");
+	testNames.push_back("List reverse and merge");
+	testNames.push_back("Deque basics");
+	testNames.push_back("Queue bursts");
+	testNames.push_back("SPSC queue");
+	testNames.push_back("MPMC queue");
+	testNames.push_back("Lock-free stack");
+	testNames.push_back("Flat map");
+	testNames.push_back("Unordered map");
+	testNames.push_back("Unordered map collisions");
+	testNames.push_back("Flat hash map and set");
 
 	std::string		testName;
 	for (size_t i = 0; i < testNames.size(); i++)
 	{
 		testName = testNames[i];
 		std::cout << "Now testing: " << testName << std::endl << std::endl;
-		calculateTimeTaken(tests[testName], testName, logger);
+		tests[testName]();
 		std::cout << std::endl;
 		std::cout << "=================================================================";
 		std::cout << std::endl << std::endl;